@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -59,6 +60,7 @@ private:
 	const uint _sampleRate;
 	bool _mixerReady;
 	uint32 _handleSeed;
+	RateConverterQuality _resamplerQuality;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
@@ -32,6 +32,8 @@
 #include "audio/rate.h"
 #include "audio/mixer.h"
 #include "common/frac.h"
+#include "common/math.h"
+#include "common/simd.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -46,6 +48,128 @@ namespace Audio {
  */
 #define INTERMEDIATE_BUFFER_SIZE 512
 
+/**
+ * The number of sample pairs the converters gather before scaling them by
+ * the channel volume and adding them to the output buffer in one go.
+ */
+#define MIX_BUFFER_SIZE 256
+
+
+#pragma mark -
+
+#if defined(SCUMMVM_SSE2) && !defined(OUTPUT_UNSIGNED_AUDIO)
+
+/**
+ * Scale four sample pairs by the volumes in vol and add them to out with
+ * saturation. The division by kMaxMixerVolume truncates towards zero, to
+ * give the same results as the scalar code.
+ */
+static FORCEINLINE __m128i mixPairs(__m128i out, __m128i in, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(in, vol);
+	const __m128i hi = _mm_mulhi_epi16(in, vol);
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_srli_epi32(_mm_srai_epi32(p0, 31), 24)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_srli_epi32(_mm_srai_epi32(p1, 31), 24)), 8);
+	return _mm_adds_epi16(out, _mm_packs_epi32(p0, p1));
+}
+
+template<bool stereo, bool reverseStereo>
+static uint mixBufferSIMD(st_sample_t *obuf, const st_sample_t *buf, uint count, st_volume_t vol_l, st_volume_t vol_r) {
+	// With reversed stereo the samples are swapped in each pair, so the
+	// right channel volume applies to the first output sample.
+	const __m128i vol = reverseStereo ? _mm_set1_epi32((vol_l << 16) | vol_r) : _mm_set1_epi32((vol_r << 16) | vol_l);
+	uint i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i in;
+		if (stereo) {
+			in = _mm_loadu_si128((const __m128i *)(buf + i * 2));
+			if (reverseStereo) {
+				in = _mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+				in = _mm_shufflehi_epi16(in, _MM_SHUFFLE(2, 3, 0, 1));
+			}
+		} else {
+			in = _mm_loadl_epi64((const __m128i *)(buf + i));
+			in = _mm_unpacklo_epi16(in, in);
+		}
+		__m128i *out = (__m128i *)(obuf + i * 2);
+		_mm_storeu_si128(out, mixPairs(_mm_loadu_si128(out), in, vol));
+	}
+
+	return i;
+}
+
+#elif defined(SCUMMVM_NEON) && !defined(OUTPUT_UNSIGNED_AUDIO)
+
+static FORCEINLINE int16x4_t scaleSamples(int16x4_t in, int16x4_t vol) {
+	int32x4_t p = vmull_s16(in, vol);
+	// Round towards zero, like the integer division of the scalar code
+	p = vaddq_s32(p, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 24)));
+	return vqmovn_s32(vshrq_n_s32(p, 8));
+}
+
+template<bool stereo, bool reverseStereo>
+static uint mixBufferSIMD(st_sample_t *obuf, const st_sample_t *buf, uint count, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16x4_t vol = vreinterpret_s16_u32(vdup_n_u32(reverseStereo ? ((vol_l << 16) | vol_r) : ((vol_r << 16) | vol_l)));
+	uint i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		int16x8_t in;
+		if (stereo) {
+			in = vld1q_s16(buf + i * 2);
+			if (reverseStereo)
+				in = vrev32q_s16(in);
+		} else {
+			const int16x4x2_t dup = vzip_s16(vld1_s16(buf + i), vld1_s16(buf + i));
+			in = vcombine_s16(dup.val[0], dup.val[1]);
+		}
+		const int16x8_t scaled = vcombine_s16(scaleSamples(vget_low_s16(in), vol), scaleSamples(vget_high_s16(in), vol));
+		vst1q_s16(obuf + i * 2, vqaddq_s16(vld1q_s16(obuf + i * 2), scaled));
+	}
+
+	return i;
+}
+
+#else
+
+template<bool stereo, bool reverseStereo>
+static uint mixBufferSIMD(st_sample_t *obuf, const st_sample_t *buf, uint count, st_volume_t vol_l, st_volume_t vol_r) {
+	return 0;
+}
+
+#endif
+
+/**
+ * Scale count samples (mono) or sample pairs (stereo) from buf by the
+ * channel volumes and add them to the stereo output buffer obuf.
+ */
+template<bool stereo, bool reverseStereo>
+static void mixBuffer(st_sample_t *obuf, const st_sample_t *buf, uint count, st_volume_t vol_l, st_volume_t vol_r) {
+	uint i = 0;
+	if (Common::hasSIMD())
+		i = mixBufferSIMD<stereo, reverseStereo>(obuf, buf, count, vol_l, vol_r);
+
+	buf += i * (stereo ? 2 : 1);
+	obuf += i * 2;
+	for (; i < count; i++) {
+		st_sample_t out0, out1;
+		out0 = *buf++;
+		out1 = (stereo ? *buf++ : out0);
+
+		// output left channel
+		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+	}
+}
+
+
+#pragma mark -
+
 
 /**
  * Audio rate converter based on simple resampling. Used when no
@@ -103,43 +227,55 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
  */
 template<bool stereo, bool reverseStereo>
 int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t mixBuf[MIX_BUFFER_SIZE * 2];
 	st_sample_t *ostart, *oend;
+	bool eos = false;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
+	while (obuf < oend && !eos) {
+		const int mixLen = MIN<int>(MIX_BUFFER_SIZE, (oend - obuf) / 2);
+		st_sample_t *mixPtr = mixBuf;
+		st_sample_t *mixEnd = mixBuf + mixLen * 2;
+
+		while (mixPtr < mixEnd) {
+
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (eos)
+				break;
 
-		// Increment output position
-		opos += opos_inc;
+			st_sample_t out0, out1;
+			out0 = *inPtr++;
+			out1 = (stereo ? *inPtr++ : out0);
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			*mixPtr++ = out0;
+			*mixPtr++ = out1;
+		}
 
-		obuf += 2;
+		const int count = (mixPtr - mixBuf) / 2;
+		mixBuffer<true, reverseStereo>(obuf, mixBuf, count, vol_l, vol_r);
+		obuf += count * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -212,53 +348,316 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
  */
 template<bool stereo, bool reverseStereo>
 int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t mixBuf[MIX_BUFFER_SIZE * 2];
 	st_sample_t *ostart, *oend;
+	bool eos = false;
 
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	while (obuf < oend && !eos) {
+		const int mixLen = MIN<int>(MIX_BUFFER_SIZE, (oend - obuf) / 2);
+		st_sample_t *mixPtr = mixBuf;
+		st_sample_t *mixEnd = mixBuf + mixLen * 2;
+
+		while (mixPtr < mixEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (eos)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the mix buffer.
+			while (opos < (frac_t)FRAC_ONE && mixPtr < mixEnd) {
+				// interpolate
+				st_sample_t out0, out1;
+				out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
+				out1 = (stereo ?
+							  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
+							  out0);
+
+				*mixPtr++ = out0;
+				*mixPtr++ = out1;
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
-						  out0);
+		const int count = (mixPtr - mixBuf) / 2;
+		mixBuffer<true, reverseStereo>(obuf, mixBuf, count, vol_l, vol_r);
+		obuf += count * 2;
+	}
+	return (obuf - ostart) / 2;
+}
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+#pragma mark -
 
-			obuf += 2;
 
-			// Increment output position
-			opos += opos_inc;
+/**
+ * The number of fractional positions between two input samples for which
+ * the windowed sinc filter kernel is precomputed.
+ */
+#define FILTER_PHASE_BITS 8
+#define FILTER_PHASES (1 << FILTER_PHASE_BITS)
+
+/** The maximum number of taps of the windowed sinc filter. */
+#define FILTER_MAX_TAPS 32
+
+/** The precision of the fixed point filter coefficients. */
+#define FILTER_COEF_BITS 14
+
+/**
+ * Compute the dot product of taps input samples with the filter kernel
+ * coefficients. taps must be a multiple of 8.
+ */
+static int32 filterSamples(const st_sample_t *in, const int16 *coefs, int taps, bool useSIMD) {
+#if defined(SCUMMVM_SSE2)
+	if (useSIMD) {
+		__m128i acc = _mm_setzero_si128();
+		for (int i = 0; i < taps; i += 8) {
+			const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+			const __m128i c = _mm_loadu_si128((const __m128i *)(coefs + i));
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(x, c));
 		}
+		acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+		acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(acc);
+	}
+#elif defined(SCUMMVM_NEON)
+	if (useSIMD) {
+		int32x4_t acc = vdupq_n_s32(0);
+		for (int i = 0; i < taps; i += 8) {
+			const int16x8_t x = vld1q_s16(in + i);
+			const int16x8_t c = vld1q_s16(coefs + i);
+			acc = vmlal_s16(acc, vget_low_s16(x), vget_low_s16(c));
+			acc = vmlal_s16(acc, vget_high_s16(x), vget_high_s16(c));
+		}
+		const int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+		return vget_lane_s32(vpadd_s32(sum, sum), 0);
+	}
+#endif
+	int32 acc = 0;
+	for (int i = 0; i < taps; i++)
+		acc += in[i] * coefs[i];
+	return acc;
+}
+
+/**
+ * Audio rate converter based on a windowed sinc filter.
+ *
+ * The Blackman windowed sinc kernel is precomputed for FILTER_PHASES
+ * fractional positions (a polyphase filter bank), so computing an output
+ * sample only takes one dot product of the input history with the kernel
+ * of the nearest phase. When downsampling, the cutoff frequency is lowered
+ * to the output Nyquist frequency to avoid aliasing.
+ *
+ * Limited to sampling frequency <= 65535 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class FilterRateConverter : public RateConverter {
+protected:
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/**
+	 * Input samples of the left/right channel. The filter window for the
+	 * current output sample starts at histPos, the window center lies
+	 * between histPos + taps / 2 - 1 and histPos + taps / 2.
+	 */
+	st_sample_t hist[2][INTERMEDIATE_BUFFER_SIZE + FILTER_MAX_TAPS];
+	int histPos;
+	int histLen;
+
+	/** fractional position of the output stream in input stream unit */
+	frac_t opos;
+
+	/** fractional position increment in the output stream */
+	frac_t opos_inc;
+
+	/** number of filter taps per phase */
+	int taps;
+
+	/** filter kernel, FILTER_PHASES + 1 phases of taps coefficients */
+	int16 *coefs;
+
+	bool refill(AudioStream &input);
+
+public:
+	FilterRateConverter(st_rate_t inrate, st_rate_t outrate, int numTaps);
+	~FilterRateConverter() {
+		delete[] coefs;
+	}
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+};
+
+
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+FilterRateConverter<stereo, reverseStereo>::FilterRateConverter(st_rate_t inrate, st_rate_t outrate, int numTaps) {
+	if (inrate >= 65536 || outrate >= 65536) {
+		error("rate effect can only handle rates < 65536");
+	}
+
+	assert(numTaps % 8 == 0 && numTaps <= FILTER_MAX_TAPS);
+	taps = numTaps;
+
+	opos = 0;
+	opos_inc = (inrate << FRAC_BITS) / outrate;
+
+	// Start with half a window of silence, so that the first output sample
+	// is centered on the first input sample.
+	memset(hist, 0, sizeof(hist));
+	histPos = 0;
+	histLen = taps / 2 - 1;
+
+	// Leave some room for the transition band below the Nyquist frequency.
+	double cutoff = 0.9;
+	if (inrate > outrate)
+		cutoff *= (double)outrate / inrate;
+
+	// The extra phase is for positions rounding up to the next input sample.
+	coefs = new int16[(FILTER_PHASES + 1) * taps];
+	for (int phase = 0; phase <= FILTER_PHASES; phase++) {
+		double kernel[FILTER_MAX_TAPS];
+		double sum = 0.0;
+		for (int i = 0; i < taps; i++) {
+			const double t = i - (taps / 2 - 1) - (double)phase / FILTER_PHASES;
+			const double x = M_PI * cutoff * t;
+			const double sinc = (x == 0.0) ? 1.0 : sin(x) / x;
+			const double window = 0.42 + 0.5 * cos(2.0 * M_PI * t / taps) + 0.08 * cos(4.0 * M_PI * t / taps);
+			kernel[i] = sinc * window;
+			sum += kernel[i];
+		}
+
+		// Normalize each phase to unity gain, and put the rounding error on
+		// the largest coefficient so that a constant signal passes unchanged.
+		int16 *c = coefs + phase * taps;
+		int total = 0, largest = 0;
+		for (int i = 0; i < taps; i++) {
+			c[i] = (int16)floor(kernel[i] / sum * (1 << FILTER_COEF_BITS) + 0.5);
+			total += c[i];
+			if (c[i] > c[largest])
+				largest = i;
+		}
+		c[largest] += (1 << FILTER_COEF_BITS) - total;
+	}
+}
+
+/*
+ * Read more input samples into the history buffers, discarding the ones
+ * which are before the current filter window.
+ */
+template<bool stereo, bool reverseStereo>
+bool FilterRateConverter<stereo, reverseStereo>::refill(AudioStream &input) {
+	if (histPos >= histLen) {
+		histPos -= histLen;
+		histLen = 0;
+	} else if (histPos > 0) {
+		histLen -= histPos;
+		memmove(hist[0], hist[0] + histPos, histLen * sizeof(st_sample_t));
+		if (stereo)
+			memmove(hist[1], hist[1] + histPos, histLen * sizeof(st_sample_t));
+		histPos = 0;
+	}
+
+	const int len = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+	if (len <= 0)
+		return false;
+
+	const st_sample_t *inPtr = inBuf;
+	if (stereo) {
+		for (int i = 0; i < len / 2; i++) {
+			hist[0][histLen + i] = *inPtr++;
+			hist[1][histLen + i] = *inPtr++;
+		}
+		histLen += len / 2;
+	} else {
+		memcpy(hist[0] + histLen, inBuf, len * sizeof(st_sample_t));
+		histLen += len;
+	}
+	return true;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int FilterRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t mixBuf[MIX_BUFFER_SIZE * 2];
+	st_sample_t *ostart, *oend;
+	const bool useSIMD = Common::hasSIMD();
+	bool eos = false;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	while (obuf < oend && !eos) {
+		const int mixLen = MIN<int>(MIX_BUFFER_SIZE, (oend - obuf) / 2);
+		st_sample_t *mixPtr = mixBuf;
+		st_sample_t *mixEnd = mixBuf + mixLen * 2;
+
+		while (mixPtr < mixEnd) {
+			// read enough input samples to fill the filter window
+			if (histPos + taps > histLen && !refill(input)) {
+				eos = true;
+				break;
+			}
+
+			// Loop as long as the filter window is filled, and as long as
+			// there is still space in the mix buffer.
+			while (histPos + taps <= histLen && mixPtr < mixEnd) {
+				const int16 *c = coefs + ((opos + (1 << (FRAC_BITS - FILTER_PHASE_BITS - 1))) >> (FRAC_BITS - FILTER_PHASE_BITS)) * taps;
+
+				int32 out0, out1;
+				out0 = (filterSamples(hist[0] + histPos, c, taps, useSIMD) + (1 << (FILTER_COEF_BITS - 1))) >> FILTER_COEF_BITS;
+				out0 = CLIP<int32>(out0, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+				if (stereo) {
+					out1 = (filterSamples(hist[1] + histPos, c, taps, useSIMD) + (1 << (FILTER_COEF_BITS - 1))) >> FILTER_COEF_BITS;
+					out1 = CLIP<int32>(out1, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+				} else {
+					out1 = out0;
+				}
+
+				*mixPtr++ = (st_sample_t)out0;
+				*mixPtr++ = (st_sample_t)out1;
+
+				// Increment output position
+				opos += opos_inc;
+				histPos += opos >> FRAC_BITS;
+				opos &= FRAC_LO_MASK;
+			}
+		}
+
+		const int count = (mixPtr - mixBuf) / 2;
+		mixBuffer<true, reverseStereo>(obuf, mixBuf, count, vol_l, vol_r);
+		obuf += count * 2;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -283,10 +682,7 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
-		st_size_t len;
-
-		st_sample_t *ostart = obuf;
+		int len;
 
 		if (stereo)
 			osamp *= 2;
@@ -304,22 +700,13 @@ public:
 		// Read up to 'osamp' samples into our temporary buffer
 		len = input.readBuffer(_buffer, osamp);
 
-		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		if (len <= 0)
+			return 0;
 
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
+		// Mix the data into the output buffer
+		len /= (stereo ? 2 : 1);
+		mixBuffer<stereo, reverseStereo>(obuf, _buffer, len, vol_l, vol_r);
+		return len;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
@@ -331,9 +718,13 @@ public:
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0) {
+		if (quality == kRateConverterSinc) {
+			return new FilterRateConverter<stereo, reverseStereo>(inrate, outrate, 16);
+		} else if (quality == kRateConverterSincBest) {
+			return new FilterRateConverter<stereo, reverseStereo>(inrate, outrate, 32);
+		} else if ((inrate % outrate) == 0) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -346,14 +737,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
@@ -78,7 +78,17 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * The interpolation used by the rate converters when the input and output
+ * rates differ.
+ */
+enum RateConverterQuality {
+	kRateConverterLinear,   ///< linear interpolation
+	kRateConverterSinc,     ///< 16 taps windowed sinc filter
+	kRateConverterSincBest  ///< 32 taps windowed sinc filter
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterLinear);
 
 } // End of namespace Audio
 
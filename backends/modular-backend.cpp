@@ -26,6 +26,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/mutex/mutex.h"
+#include "backends/thread/thread.h"
 #include "gui/EventRecorder.h"
 
 #include "audio/mixer.h"
@@ -35,6 +36,7 @@
 ModularBackend::ModularBackend()
 	:
 	_mutexManager(0),
+	_threadManager(0),
 	_graphicsManager(0),
 	_mixer(0) {
 
@@ -45,6 +47,8 @@ ModularBackend::~ModularBackend() {
 	_graphicsManager = 0;
 	delete _mixer;
 	_mixer = 0;
+	delete _threadManager;
+	_threadManager = 0;
 	delete _mutexManager;
 	_mutexManager = 0;
 }
@@ -248,6 +252,49 @@ void ModularBackend::deleteMutex(MutexRef mutex) {
 	_mutexManager->deleteMutex(mutex);
 }
 
+OSystem::ThreadRef ModularBackend::createThread(ThreadProc proc, void *param) {
+	if (!_threadManager)
+		return 0;
+	return _threadManager->createThread(proc, param);
+}
+
+void ModularBackend::joinThread(ThreadRef thread) {
+	assert(_threadManager);
+	_threadManager->joinThread(thread);
+}
+
+OSystem::ConditionRef ModularBackend::createCondition() {
+	if (!_threadManager)
+		return 0;
+	return _threadManager->createCondition();
+}
+
+void ModularBackend::waitCondition(ConditionRef cond, MutexRef mutex) {
+	assert(_threadManager);
+	_threadManager->waitCondition(cond, mutex);
+}
+
+void ModularBackend::signalCondition(ConditionRef cond) {
+	assert(_threadManager);
+	_threadManager->signalCondition(cond);
+}
+
+void ModularBackend::broadcastCondition(ConditionRef cond) {
+	assert(_threadManager);
+	_threadManager->broadcastCondition(cond);
+}
+
+void ModularBackend::deleteCondition(ConditionRef cond) {
+	assert(_threadManager);
+	_threadManager->deleteCondition(cond);
+}
+
+uint32 ModularBackend::getThreadId() {
+	if (!_threadManager)
+		return 0;
+	return _threadManager->getThreadId();
+}
+
 Audio::Mixer *ModularBackend::getMixer() {
 	assert(_mixer);
 	return (Audio::Mixer *)_mixer;
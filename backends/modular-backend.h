@@ -27,6 +27,7 @@
 
 class GraphicsManager;
 class MutexManager;
+class ThreadManager;
 
 /**
  * Base class for modular backends.
@@ -118,6 +119,20 @@ public:
 
 	//@}
 
+	/** @name Worker threads */
+	//@{
+
+	virtual ThreadRef createThread(ThreadProc proc, void *param);
+	virtual void joinThread(ThreadRef thread);
+	virtual ConditionRef createCondition();
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex);
+	virtual void signalCondition(ConditionRef cond);
+	virtual void broadcastCondition(ConditionRef cond);
+	virtual void deleteCondition(ConditionRef cond);
+	virtual uint32 getThreadId();
+
+	//@}
+
 	/** @name Sound */
 	//@{
 
@@ -138,6 +153,7 @@ protected:
 	//@{
 
 	MutexManager *_mutexManager;
+	ThreadManager *_threadManager;
 	GraphicsManager *_graphicsManager;
 	Audio::Mixer *_mixer;
 
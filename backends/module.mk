@@ -61,6 +61,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
 	plugins/sdl/sdl-provider.o \
+	thread/sdl/sdl-thread.o \
 	timer/sdl/sdl-timer.o
 
 # SDL 1.3 removed audio CD support
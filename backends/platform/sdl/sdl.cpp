@@ -45,6 +45,7 @@
 
 #include "backends/events/sdl/sdl-events.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/thread/sdl/sdl-thread.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 
@@ -97,6 +98,8 @@ OSystem_SDL::~OSystem_SDL() {
 #endif
 
 	_timerManager = 0;
+	delete _threadManager;
+	_threadManager = 0;
 	delete _mutexManager;
 	_mutexManager = 0;
 
@@ -125,6 +128,9 @@ void OSystem_SDL::init() {
 	if (_mutexManager == 0)
 		_mutexManager = new SdlMutexManager();
 
+	if (_threadManager == 0)
+		_threadManager = new SdlThreadManager();
+
 #if defined(USE_TASKBAR)
 	if (_taskbarManager == 0)
 		_taskbarManager = new Common::TaskbarManager();
@@ -142,6 +148,21 @@ void OSystem_SDL::initBackend() {
 
 	int graphicsManagerType = 0;
 
+#ifdef ENABLE_EVENTRECORDER
+	// Headless playback of recordings, for benchmarks: draw with the software
+	// renderer on SDL's offscreen video driver.
+	if (ConfMan.getBool("disable_display")) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+#else
+		SDL_putenv(const_cast<char *>("SDL_VIDEODRIVER=dummy"));
+		SDL_putenv(const_cast<char *>("SDL_AUDIODRIVER=dummy"));
+#endif
+		ConfMan.setBool("soft_renderer", true, Common::ConfigManager::kTransientDomain);
+	}
+#endif
+
 	if (_graphicsManager == 0) {
 		if (_graphicsManager == 0) {
 			_graphicsManager = new SurfaceSdlGraphicsManager(_eventSource);
@@ -443,6 +464,17 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// Split the conversion so that it doesn't overflow with fast counters
+	uint64 counter = SDL_GetPerformanceCounter();
+	uint64 frequency = SDL_GetPerformanceFrequency();
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
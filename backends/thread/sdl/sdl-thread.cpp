@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/thread/sdl/sdl-thread.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+
+OSystem::ThreadRef SdlThreadManager::createThread(OSystem::ThreadProc proc, void *param) {
+#if SDL_VERSION_ATLEAST(1, 3, 0)
+	return (OSystem::ThreadRef) SDL_CreateThread(proc, "ResidualVM worker", param);
+#else
+	return (OSystem::ThreadRef) SDL_CreateThread(proc, param);
+#endif
+}
+
+void SdlThreadManager::joinThread(OSystem::ThreadRef thread) {
+	SDL_WaitThread((SDL_Thread *)thread, 0);
+}
+
+OSystem::ConditionRef SdlThreadManager::createCondition() {
+	return (OSystem::ConditionRef) SDL_CreateCond();
+}
+
+void SdlThreadManager::waitCondition(OSystem::ConditionRef cond, OSystem::MutexRef mutex) {
+	SDL_CondWait((SDL_cond *)cond, (SDL_mutex *)mutex);
+}
+
+void SdlThreadManager::signalCondition(OSystem::ConditionRef cond) {
+	SDL_CondSignal((SDL_cond *)cond);
+}
+
+void SdlThreadManager::broadcastCondition(OSystem::ConditionRef cond) {
+	SDL_CondBroadcast((SDL_cond *)cond);
+}
+
+void SdlThreadManager::deleteCondition(OSystem::ConditionRef cond) {
+	SDL_DestroyCond((SDL_cond *)cond);
+}
+
+uint32 SdlThreadManager::getThreadId() {
+	return (uint32)SDL_ThreadID();
+}
+
+#endif
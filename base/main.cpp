@@ -44,6 +44,7 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/profiler.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -464,6 +465,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(g_eventRec.generateRecordFileName(ConfMan.getActiveDomainName()), GUI::EventRecorder::kRecorderRecord);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "benchmark") {
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback, true);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
@@ -533,6 +536,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Common::DebugManager::destroy();
 #ifdef ENABLE_EVENTRECORDER
 	GUI::EventRecorder::destroy();
+#endif
+#ifdef ENABLE_ZONE_PROFILER
+	Common::Profiler::destroy();
 #endif
 	Common::SearchManager::destroy();
 #ifdef USE_TRANSLATION
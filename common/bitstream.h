@@ -26,7 +26,9 @@
 #define COMMON_BITSTREAM_H
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 #include "common/textconsole.h"
+#include "common/types.h"
 #include "common/stream.h"
 
 namespace Common {
@@ -67,6 +69,9 @@ public:
 	/** Add a bit to the value x, making it an n+1-bit value. */
 	virtual void addBit(uint32 &x, uint32 n) = 0;
 
+	/** Are the bits handed out from MSB to LSB? */
+	virtual bool isMSBFirst() const = 0;
+
 protected:
 	BitStream() {
 	}
@@ -262,6 +267,11 @@ public:
 			x = (x & ~(1 << n)) | (getBit() << n);
 	}
 
+	/** Are the bits handed out from MSB to LSB? */
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
+
 	/** Rewind the bit stream back to the start. */
 	void rewind() {
 		_stream->seek(0);
@@ -320,6 +330,238 @@ typedef BitStreamImpl<32, false, true > BitStream32BEMSB;
 /** 32-bit big-endian data, LSB to MSB. */
 typedef BitStreamImpl<32, false, false> BitStream32BELSB;
 
+/**
+ * A template implementing a bit stream over a memory buffer.
+ *
+ * It hands out the same bits as a BitStreamImpl with the same layout
+ * parameters, but keeps up to 64 bits of the buffer cached, which are
+ * handed out several at a time. The methods are not virtual, so that
+ * decoders taking the bit stream type as a template parameter can have
+ * them inlined.
+ */
+template<int valueBits, bool isLE, bool isMSB2LSB>
+class BitStreamMemoryImpl {
+private:
+	const byte *_data; ///< The input data.
+	const byte *_end;  ///< End of the last whole value of the input data.
+	const byte *_ptr;  ///< Next value to be cached.
+
+	DisposeAfterUse::Flag _disposeAfterUse; ///< Should we free the data on destruction?
+
+	uint64 _cache;     ///< Cached bits, the next one at the MSB or the LSB.
+	uint8  _cacheBits; ///< Number of bits in the cache.
+
+	/** Read a data value. */
+	inline uint32 readData() const {
+		if (valueBits == 8)
+			return *_ptr;
+		if (valueBits == 16)
+			return isLE ? READ_LE_UINT16(_ptr) : READ_BE_UINT16(_ptr);
+
+		return isLE ? READ_LE_UINT32(_ptr) : READ_BE_UINT32(_ptr);
+	}
+
+	/** Cache as many data values as there is room for. */
+	inline void refill() {
+		while (_cacheBits <= 64 - valueBits && _ptr < _end) {
+			uint64 value = readData();
+			_ptr += valueBits / 8;
+
+			if (isMSB2LSB)
+				_cache |= value << (64 - valueBits - _cacheBits);
+			else
+				_cache |= value << _cacheBits;
+
+			_cacheBits += valueBits;
+		}
+	}
+
+	/** Make sure at least n bits are cached. */
+	inline void fill(uint8 n) {
+		if (_cacheBits < n) {
+			refill();
+
+			if (_cacheBits < n)
+				error("BitStreamMemoryImpl::fill(): End of bit stream reached");
+		}
+	}
+
+	/** Return the next 1 to 32 cached bits. */
+	inline uint32 cached(uint8 n) const {
+		if (isMSB2LSB)
+			return (uint32)(_cache >> (64 - n));
+		else
+			return (uint32)(_cache & ((((uint64)1) << n) - 1));
+	}
+
+	/** Drop less than 64 cached bits. */
+	inline void consume(uint8 n) {
+		if (isMSB2LSB)
+			_cache <<= n;
+		else
+			_cache >>= n;
+
+		_cacheBits -= n;
+	}
+
+public:
+	/** Create a bit stream over this data and optionally free it on destruction. */
+	BitStreamMemoryImpl(const byte *data, uint32 size, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::NO) :
+		_data(data), _end(data + (size & ~((uint32) ((valueBits >> 3) - 1)))), _ptr(data),
+		_disposeAfterUse(disposeAfterUse), _cache(0), _cacheBits(0) {
+
+		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
+			error("BitStreamMemoryImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+	}
+
+	~BitStreamMemoryImpl() {
+		if (_disposeAfterUse == DisposeAfterUse::YES)
+			free(const_cast<byte *>(_data));
+	}
+
+	/** Read a bit from the bit stream. */
+	uint32 getBit() {
+		fill(1);
+
+		uint32 b = cached(1);
+		consume(1);
+		return b;
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream.
+	 *
+	 * The bit order is the same as in BitStreamImpl::getBits().
+	 */
+	uint32 getBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemoryImpl::getBits(): Too many bits requested to be read");
+
+		fill(n);
+
+		uint32 v = cached(n);
+		consume(n);
+		return v;
+	}
+
+	/** Read a bit from the bit stream, without changing the stream's position. */
+	uint32 peekBit() {
+		fill(1);
+		return cached(1);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream, without changing the stream's position.
+	 *
+	 * The bit order is the same as in getBits().
+	 */
+	uint32 peekBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemoryImpl::peekBits(): Too many bits requested to be read");
+
+		fill(n);
+		return cached(n);
+	}
+
+	/**
+	 * Add a bit to the value x, making it an n+1-bit value.
+	 *
+	 * See BitStreamImpl::addBit().
+	 */
+	void addBit(uint32 &x, uint32 n) {
+		if (n >= 32)
+			error("BitStreamMemoryImpl::addBit(): Too many bits requested to be read");
+
+		if (isMSB2LSB)
+			x = (x << 1) | getBit();
+		else
+			x = (x & ~(1 << n)) | (getBit() << n);
+	}
+
+	/** Are the bits handed out from MSB to LSB? */
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
+
+	/** Rewind the bit stream back to the start. */
+	void rewind() {
+		_ptr = _data;
+
+		_cache     = 0;
+		_cacheBits = 0;
+	}
+
+	/** Skip the specified amount of bits. */
+	void skip(uint32 n) {
+		if (n < _cacheBits) {
+			consume(n);
+			return;
+		}
+
+		n -= _cacheBits;
+		_cache     = 0;
+		_cacheBits = 0;
+
+		// Skip the whole values without caching them
+		uint32 values = n / valueBits;
+		if (values > (uint32)(_end - _ptr) / (valueBits / 8))
+			error("BitStreamMemoryImpl::skip(): End of bit stream reached");
+
+		_ptr += values * (valueBits / 8);
+		n %= valueBits;
+
+		if (n > 0) {
+			fill(n);
+			consume(n);
+		}
+	}
+
+	/** Return the stream position in bits. */
+	uint32 pos() const {
+		return (_ptr - _data) * 8 - _cacheBits;
+	}
+
+	/** Return the stream size in bits. */
+	uint32 size() const {
+		return (_end - _data) * 8;
+	}
+
+	bool eos() const {
+		return pos() >= size();
+	}
+};
+
+// typedefs for various memory layouts.
+
+/** 8-bit data, MSB to LSB. */
+typedef BitStreamMemoryImpl<8, false, true > BitStreamMemory8MSB;
+/** 8-bit data, LSB to MSB. */
+typedef BitStreamMemoryImpl<8, false, false> BitStreamMemory8LSB;
+
+/** 16-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, true , true > BitStreamMemory16LEMSB;
+/** 16-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, true , false> BitStreamMemory16LELSB;
+/** 16-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, false, true > BitStreamMemory16BEMSB;
+/** 16-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, false, false> BitStreamMemory16BELSB;
+
+/** 32-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, true , true > BitStreamMemory32LEMSB;
+/** 32-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, true , false> BitStreamMemory32LELSB;
+/** 32-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, false, true > BitStreamMemory32BEMSB;
+/** 32-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, false, false> BitStreamMemory32BELSB;
+
 } // End of namespace Common
 
 #endif // COMMON_BITSTREAM_H
@@ -65,6 +65,11 @@ void DCT::calc(float *data) {
 	}
 }
 
+void DCT::calc(float **data, uint count) {
+	for (uint i = 0; i < count; i++)
+		calc(data[i]);
+}
+
 /* sin((M_PI * x / (2*n)) */
 #define SIN(n,x) (_tCos[(n) - (x)])
 /* cos((M_PI * x / (2*n)) */
@@ -28,6 +28,7 @@
 
 #include "common/cosinetables.h"
 #include "common/fft.h"
+#include "common/fft_simd.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -156,6 +157,11 @@ static void name(Complex *z, const float *wre, unsigned int n) { \
 	\
 	TRANSFORM_ZERO(z[0], z[o1], z[o2], z[o3]); \
 	TRANSFORM(z[1], z[o1 + 1], z[o2 + 1], z[o3 + 1], wre[1], wim[-1]); \
+	\
+	/* The vectorized butterflies do all the remaining pairs, or none */ \
+	if (fftPassSIMD(z, wre, n + 1)) \
+		return; \
+	\
 	do { \
 		z += 2; \
 		wre += 2; \
@@ -0,0 +1,254 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/simd.h"
+#include "common/fft_simd.h"
+
+namespace Common {
+
+#if defined(SCUMMVM_SSE2)
+
+// Each vector holds two complex numbers, re0 im0 re1 im1
+
+static inline __m128 swapReIm(__m128 a) {
+	return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128 swapHalves(__m128 a) {
+	return _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+uint fftPassSIMD(Complex *z, const float *wre, uint n) {
+	if (!hasSIMD())
+		return 0;
+
+	const uint o1 = 2 * n;
+	const uint o2 = 4 * n;
+	const uint o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Negate the imaginary, or the real parts
+	const __m128 negIm = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+	const __m128 negRe = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+	for (uint k = 1; k < n; k++) {
+		float *p = &z[2 * k].re;
+
+		// wre[2k] wre[2k] wre[2k + 1] wre[2k + 1], and likewise wim[-2k] wim[-2k - 1]
+		__m128 w = _mm_castpd_ps(_mm_load_sd((const double *)(wre + 2 * k)));
+		w = _mm_unpacklo_ps(w, w);
+		__m128 v = _mm_castpd_ps(_mm_load_sd((const double *)(wim - 2 * k - 1)));
+		v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 1, 1));
+
+		__m128 a0 = _mm_loadu_ps(p);
+		__m128 a1 = _mm_loadu_ps(p + 2 * o1);
+		__m128 a2 = _mm_loadu_ps(p + 2 * o2);
+		__m128 a3 = _mm_loadu_ps(p + 2 * o3);
+
+		// t1 t2 and t5 t6 of TRANSFORM()
+		__m128 t12 = _mm_add_ps(_mm_mul_ps(a2, w), _mm_xor_ps(_mm_mul_ps(swapReIm(a2), v), negIm));
+		__m128 t56 = _mm_add_ps(_mm_mul_ps(a3, w), _mm_xor_ps(_mm_mul_ps(swapReIm(a3), v), negRe));
+
+		// t5 t6 and t4 t3 of BUTTERFLIES()
+		__m128 sum = _mm_add_ps(t12, t56);
+		__m128 diff = swapReIm(_mm_xor_ps(_mm_sub_ps(t56, t12), negIm));
+
+		_mm_storeu_ps(p,          _mm_add_ps(a0, sum));
+		_mm_storeu_ps(p + 2 * o2, _mm_sub_ps(a0, sum));
+		_mm_storeu_ps(p + 2 * o1, _mm_add_ps(a1, diff));
+		_mm_storeu_ps(p + 2 * o3, _mm_sub_ps(a1, diff));
+	}
+
+	return n - 1;
+}
+
+int rdftTwiddleSIMD(float *data, int n, const float *tCos, const float *tSin, float k1, float k2) {
+	if (!hasSIMD())
+		return 1;
+
+	const __m128 vk1 = _mm_set1_ps(k1);
+	const __m128 vk2 = _mm_set1_ps(k2);
+	const __m128 vnk2 = _mm_set1_ps(-k2);
+	const __m128 sign = _mm_set1_ps(-0.0f);
+
+	int i = 1;
+	for (; i + 4 <= (n >> 2); i += 4) {
+		// The elements i to i + 3 from the start, and from the end
+		float *p1 = data + 2 * i;
+		float *p2 = data + n - 2 * i - 6;
+
+		__m128 x0 = _mm_loadu_ps(p1);
+		__m128 x1 = _mm_loadu_ps(p1 + 4);
+		__m128 y0 = _mm_loadu_ps(p2);
+		__m128 y1 = _mm_loadu_ps(p2 + 4);
+
+		__m128 aRe = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 aIm = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+		__m128 bRe = _mm_shuffle_ps(y1, y0, _MM_SHUFFLE(0, 2, 0, 2));
+		__m128 bIm = _mm_shuffle_ps(y1, y0, _MM_SHUFFLE(1, 3, 1, 3));
+
+		__m128 evRe = _mm_mul_ps(vk1, _mm_add_ps(aRe, bRe));
+		__m128 odIm = _mm_mul_ps(vnk2, _mm_sub_ps(aRe, bRe));
+		__m128 evIm = _mm_mul_ps(vk1, _mm_sub_ps(aIm, bIm));
+		__m128 odRe = _mm_mul_ps(vk2, _mm_add_ps(aIm, bIm));
+
+		__m128 c = _mm_loadu_ps(tCos + i);
+		__m128 s = _mm_loadu_ps(tSin + i);
+
+		__m128 odReC = _mm_mul_ps(odRe, c);
+		__m128 odReS = _mm_mul_ps(odRe, s);
+		__m128 odImC = _mm_mul_ps(odIm, c);
+		__m128 odImS = _mm_mul_ps(odIm, s);
+
+		aRe = _mm_sub_ps(_mm_add_ps(evRe, odReC), odImS);
+		aIm = _mm_add_ps(_mm_add_ps(evIm, odImC), odReS);
+		bRe = _mm_add_ps(_mm_sub_ps(evRe, odReC), odImS);
+		bIm = _mm_add_ps(_mm_add_ps(_mm_xor_ps(evIm, sign), odImC), odReS);
+
+		_mm_storeu_ps(p1,     _mm_unpacklo_ps(aRe, aIm));
+		_mm_storeu_ps(p1 + 4, _mm_unpackhi_ps(aRe, aIm));
+		_mm_storeu_ps(p2 + 4, swapHalves(_mm_unpacklo_ps(bRe, bIm)));
+		_mm_storeu_ps(p2,     swapHalves(_mm_unpackhi_ps(bRe, bIm)));
+	}
+
+	return i;
+}
+
+#elif defined(SCUMMVM_NEON)
+
+// Each vector holds two complex numbers, re0 im0 re1 im1
+
+static inline float32x4_t xorSign(float32x4_t a, uint32x4_t mask) {
+	return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), mask));
+}
+
+static inline float32x4_t reverse(float32x4_t a) {
+	a = vrev64q_f32(a);
+	return vcombine_f32(vget_high_f32(a), vget_low_f32(a));
+}
+
+uint fftPassSIMD(Complex *z, const float *wre, uint n) {
+	if (!hasSIMD())
+		return 0;
+
+	const uint o1 = 2 * n;
+	const uint o2 = 4 * n;
+	const uint o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Negate the imaginary, or the real parts
+	static const uint32 negImBits[4] = { 0, 0x80000000, 0, 0x80000000 };
+	static const uint32 negReBits[4] = { 0x80000000, 0, 0x80000000, 0 };
+	const uint32x4_t negIm = vld1q_u32(negImBits);
+	const uint32x4_t negRe = vld1q_u32(negReBits);
+
+	for (uint k = 1; k < n; k++) {
+		float *p = &z[2 * k].re;
+
+		// wre[2k] wre[2k] wre[2k + 1] wre[2k + 1], and likewise wim[-2k] wim[-2k - 1]
+		float32x2_t wr = vld1_f32(wre + 2 * k);
+		float32x4_t w = vcombine_f32(vdup_lane_f32(wr, 0), vdup_lane_f32(wr, 1));
+		float32x2_t vi = vld1_f32(wim - 2 * k - 1);
+		float32x4_t v = vcombine_f32(vdup_lane_f32(vi, 1), vdup_lane_f32(vi, 0));
+
+		float32x4_t a0 = vld1q_f32(p);
+		float32x4_t a1 = vld1q_f32(p + 2 * o1);
+		float32x4_t a2 = vld1q_f32(p + 2 * o2);
+		float32x4_t a3 = vld1q_f32(p + 2 * o3);
+
+		// t1 t2 and t5 t6 of TRANSFORM(), multiplied and added separately
+		// so that they are rounded like the scalar code
+		float32x4_t t12 = vaddq_f32(vmulq_f32(a2, w), xorSign(vmulq_f32(vrev64q_f32(a2), v), negIm));
+		float32x4_t t56 = vaddq_f32(vmulq_f32(a3, w), xorSign(vmulq_f32(vrev64q_f32(a3), v), negRe));
+
+		// t5 t6 and t4 t3 of BUTTERFLIES()
+		float32x4_t sum = vaddq_f32(t12, t56);
+		float32x4_t diff = vrev64q_f32(xorSign(vsubq_f32(t56, t12), negIm));
+
+		vst1q_f32(p,          vaddq_f32(a0, sum));
+		vst1q_f32(p + 2 * o2, vsubq_f32(a0, sum));
+		vst1q_f32(p + 2 * o1, vaddq_f32(a1, diff));
+		vst1q_f32(p + 2 * o3, vsubq_f32(a1, diff));
+	}
+
+	return n - 1;
+}
+
+int rdftTwiddleSIMD(float *data, int n, const float *tCos, const float *tSin, float k1, float k2) {
+	if (!hasSIMD())
+		return 1;
+
+	const float32x4_t vk1 = vdupq_n_f32(k1);
+	const float32x4_t vk2 = vdupq_n_f32(k2);
+	const float32x4_t vnk2 = vdupq_n_f32(-k2);
+
+	int i = 1;
+	for (; i + 4 <= (n >> 2); i += 4) {
+		// The elements i to i + 3 from the start, and from the end
+		float *p1 = data + 2 * i;
+		float *p2 = data + n - 2 * i - 6;
+
+		float32x4x2_t a = vld2q_f32(p1);
+		float32x4x2_t b = vld2q_f32(p2);
+		float32x4_t aRe = a.val[0];
+		float32x4_t aIm = a.val[1];
+		float32x4_t bRe = reverse(b.val[0]);
+		float32x4_t bIm = reverse(b.val[1]);
+
+		float32x4_t evRe = vmulq_f32(vk1, vaddq_f32(aRe, bRe));
+		float32x4_t odIm = vmulq_f32(vnk2, vsubq_f32(aRe, bRe));
+		float32x4_t evIm = vmulq_f32(vk1, vsubq_f32(aIm, bIm));
+		float32x4_t odRe = vmulq_f32(vk2, vaddq_f32(aIm, bIm));
+
+		float32x4_t c = vld1q_f32(tCos + i);
+		float32x4_t s = vld1q_f32(tSin + i);
+
+		float32x4_t odReC = vmulq_f32(odRe, c);
+		float32x4_t odReS = vmulq_f32(odRe, s);
+		float32x4_t odImC = vmulq_f32(odIm, c);
+		float32x4_t odImS = vmulq_f32(odIm, s);
+
+		a.val[0] = vsubq_f32(vaddq_f32(evRe, odReC), odImS);
+		a.val[1] = vaddq_f32(vaddq_f32(evIm, odImC), odReS);
+		b.val[0] = reverse(vaddq_f32(vsubq_f32(evRe, odReC), odImS));
+		b.val[1] = reverse(vaddq_f32(vaddq_f32(vnegq_f32(evIm), odImC), odReS));
+
+		vst2q_f32(p1, a);
+		vst2q_f32(p2, b);
+	}
+
+	return i;
+}
+
+#else
+
+uint fftPassSIMD(Complex *z, const float *wre, uint n) {
+	return 0;
+}
+
+int rdftTwiddleSIMD(float *data, int n, const float *tCos, const float *tSin, float k1, float k2) {
+	return 1;
+}
+
+#endif
+
+} // End of namespace Common
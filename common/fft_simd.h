@@ -0,0 +1,63 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/**
+ * @file
+ * Vectorized butterflies of the split-radix FFT and of the RDFT, used by
+ * Common::FFT and Common::RDFT.
+ *
+ * They compute every value with the same operations, in the same order,
+ * as the scalar code, so the results only differ where the vector unit
+ * rounds differently (NEON flushes denormals to zero). They return how
+ * much of the work they did; the caller does the rest with the scalar
+ * code.
+ */
+
+#ifndef COMMON_FFT_SIMD_H
+#define COMMON_FFT_SIMD_H
+
+#include "common/scummsys.h"
+#include "common/math.h"
+
+namespace Common {
+
+/**
+ * Run the combining pass of a split-radix FFT over all but the first
+ * two elements of each quarter of z[0...8n-1], with the twiddle factors
+ * w[0...2n-1] (real parts) and w[2n...4n-1] (imaginary parts, reversed).
+ *
+ * @return the number of element pairs done after the first one, either
+ *         n - 1 or 0 if no vectorized path is available
+ */
+uint fftPassSIMD(Complex *z, const float *wre, uint n);
+
+/**
+ * Separate the even and odd FFTs packed in an RDFT of n floats, and
+ * apply the twiddle factors, starting at the complex element 1.
+ *
+ * @return the index of the first element that was not processed
+ */
+int rdftTwiddleSIMD(float *data, int n, const float *tCos, const float *tSin, float k1, float k2);
+
+} // End of namespace Common
+
+#endif
@@ -25,11 +25,10 @@
 #include "common/huffman.h"
 #include "common/util.h"
 #include "common/textconsole.h"
-#include "common/bitstream.h"
 
 namespace Common {
 
-Huffman::Symbol::Symbol(uint32 c, uint32 s) : code(c), symbol(s) {
+Huffman::Symbol::Symbol(uint32 c, uint8 l, uint32 s) : code(c), length(l), symbol(s) {
 }
 
 
@@ -45,19 +44,17 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 
 	assert(maxLength <= 32);
 
-	_codes.resize(maxLength);
-	_symbols.resize(codeCount);
+	_tableBits = MIN<uint8>(maxLength, kMaxTableBits);
+	_symbols.reserve(codeCount);
 
 	for (uint32 i = 0; i < codeCount; i++) {
 		// The symbol. If none were specified, just assume it's identical to the code index
 		uint32 symbol = symbols ? symbols[i] : i;
 
-		// Put the code and symbol into the correct list
-		_codes[lengths[i] - 1].push_back(Symbol(codes[i], symbol));
-
-		// And put the pointer to the symbol/code struct into the symbol list.
-		_symbols[i] = &_codes[lengths[i] - 1].back();
+		_symbols.push_back(Symbol(codes[i], lengths[i], symbol));
 	}
+
+	buildTables();
 }
 
 Huffman::~Huffman() {
@@ -65,22 +62,90 @@ Huffman::~Huffman() {
 
 void Huffman::setSymbols(const uint32 *symbols) {
 	for (uint32 i = 0; i < _symbols.size(); i++)
-		_symbols[i]->symbol = symbols ? *symbols++ : i;
+		_symbols[i].symbol = symbols ? *symbols++ : i;
+
+	// The symbols are stored in the tables
+	buildTables();
+}
+
+void Huffman::buildTables() {
+	// Sort the codes by length, so that the first of several identical
+	// codes wins, and a code shadows the longer ones it is a prefix of.
+	SymbolList sorted;
+	sorted.reserve(_symbols.size());
+
+	for (uint8 length = 1; length <= 32; length++) {
+		for (uint32 i = 0; i < _symbols.size(); i++) {
+			const Symbol &s = _symbols[i];
+
+			// Codes with bits above their length can never be matched
+			if (s.length == length && (length == 32 || (s.code >> length) == 0))
+				sorted.push_back(s);
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		_tables[i].clear();
+		_tables[i].resize(1 << _tableBits);
+		buildTable(_tables[i], 0, _tableBits, sorted, i == 0);
+	}
 }
 
-uint32 Huffman::getSymbol(BitStream &bits) const {
-	uint32 code = 0;
+void Huffman::buildTable(Table &table, uint32 offset, uint8 bits, const SymbolList &symbols, bool msbFirst) {
+	// The remaining bits of the codes longer than this table's index, by prefix
+	Array<SymbolList> subSymbols;
+	subSymbols.resize(1 << bits);
+
+	for (uint32 i = 0; i < symbols.size(); i++) {
+		const Symbol &s = symbols[i];
+
+		if (s.length > bits) {
+			uint8 length = s.length - bits;
+			uint32 prefix, rest;
+			if (msbFirst) {
+				prefix = s.code >> length;
+				rest = s.code & ((1 << length) - 1);
+			} else {
+				prefix = s.code & ((1 << bits) - 1);
+				rest = s.code >> bits;
+			}
+
+			subSymbols[prefix].push_back(Symbol(rest, length, s.symbol));
+			continue;
+		}
+
+		// Fill all the entries starting with the code
+		uint32 count = 1 << (bits - s.length);
+		for (uint32 j = 0; j < count; j++) {
+			uint32 index = msbFirst ? ((s.code << (bits - s.length)) | j) : (s.code | (j << s.length));
+
+			TableEntry &entry = table[offset + index];
+			if (entry.length == 0) {
+				entry.value = s.symbol;
+				entry.length = s.length;
+			}
+		}
+	}
 
-	for (uint32 i = 0; i < _codes.size(); i++) {
-		bits.addBit(code, i);
+	for (uint32 prefix = 0; prefix < subSymbols.size(); prefix++) {
+		const SymbolList &sub = subSymbols[prefix];
+		if (sub.empty() || table[offset + prefix].length != 0)
+			continue;
 
-		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-			if (code == cCode->code)
-				return cCode->symbol;
+		// The codes are still sorted by length
+		uint8 subBits = MIN<uint8>(sub.back().length, kMaxTableBits);
+		uint32 subOffset = table.size();
+		table.resize(subOffset + (1 << subBits));
+
+		table[offset + prefix].value = subOffset;
+		table[offset + prefix].subBits = subBits;
+
+		buildTable(table, subOffset, subBits, sub, msbFirst);
 	}
+}
 
+void Huffman::unknownCode() {
 	error("Unknown Huffman code");
-	return 0;
 }
 
 } // End of namespace Common
@@ -26,7 +26,6 @@
 #define COMMON_HUFFMAN_H
 
 #include "common/array.h"
-#include "common/list.h"
 #include "common/types.h"
 
 namespace Common {
@@ -36,6 +35,10 @@ class BitStream;
 /**
  * Huffman bitstream decoding
  *
+ * The codes are decoded through lookup tables indexed by several bits
+ * at once. Codes longer than the first table's index point to further
+ * tables, indexed by the following bits.
+ *
  * Used in engines:
  *  - scumm
  */
@@ -55,28 +58,96 @@ public:
 	/** Modify the codes' symbols. */
 	void setSymbols(const uint32 *symbols = 0);
 
-	/** Return the next symbol in the bitstream. */
-	uint32 getSymbol(BitStream &bits) const;
+	/**
+	 * Return the next symbol in the bitstream.
+	 *
+	 * This is a template, so that the calls to the bit stream are not
+	 * virtual when it is a BitStreamMemoryImpl.
+	 */
+	template<class BITSTREAM>
+	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
+	/** Maximal number of bits indexing a lookup table. */
+	static const uint8 kMaxTableBits = 9;
+
 	struct Symbol {
 		uint32 code;
+		uint8 length;
 		uint32 symbol;
 
-		Symbol(uint32 c, uint32 s);
+		Symbol(uint32 c, uint8 l, uint32 s);
 	};
 
-	typedef List<Symbol> CodeList;
-	typedef Array<CodeList> CodeLists;
-	typedef Array<Symbol *> SymbolList;
+	struct TableEntry {
+		uint32 value;  ///< The symbol, or the offset of the next level table.
+		uint8 length;  ///< Length of the code in this table, 0 if it continues in another one.
+		uint8 subBits; ///< Number of bits indexing the next level table.
+	};
 
-	/** Lists of codes and their symbols, sorted by code length. */
-	CodeLists _codes;
+	typedef Array<Symbol> SymbolList;
+	typedef Array<TableEntry> Table;
 
-	/** Sorted list of pointers to the symbols. */
+	/** The codes and their symbols, in the order they were given. */
 	SymbolList _symbols;
+
+	/** Number of bits indexing the first table. */
+	uint8 _tableBits;
+
+	/** The lookup tables, for the streams read from MSB to LSB and LSB to MSB. */
+	Table _tables[2];
+
+	void buildTables();
+	static void buildTable(Table &table, uint32 offset, uint8 bits, const SymbolList &symbols, bool msbFirst);
+
+	static void unknownCode();
 };
 
+template<class BITSTREAM>
+uint32 Huffman::getSymbol(BITSTREAM &bits) const {
+	const bool msbFirst = bits.isMSBFirst();
+	const TableEntry *table = _tables[msbFirst ? 0 : 1].begin();
+
+	const uint32 size = bits.size();
+	const uint32 pos = bits.pos();
+	uint32 available = (pos < size) ? size - pos : 0;
+	uint8 width = _tableBits;
+
+	while (true) {
+		uint32 index;
+		if (available >= width) {
+			index = bits.peekBits(width);
+		} else {
+			// Pad the end of the stream with zeros, only codes which fit can match
+			index = bits.peekBits(available);
+			if (msbFirst)
+				index <<= width - available;
+		}
+
+		const TableEntry &entry = table[index];
+
+		if (entry.length != 0) {
+			if (entry.length > available)
+				break;
+
+			bits.skip(entry.length);
+			return entry.value;
+		}
+
+		if (entry.subBits == 0 || width > available)
+			break;
+
+		bits.skip(width);
+		available -= width;
+
+		table = _tables[msbFirst ? 0 : 1].begin() + entry.value;
+		width = entry.subBits;
+	}
+
+	unknownCode();
+	return 0;
+}
+
 } // End of namespace Common
 
 #endif // COMMON_HUFFMAN_H
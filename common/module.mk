@@ -22,10 +22,12 @@ MODULE_OBJS := \
 	random.o \
 	rational.o \
 	rendermode.o \
+	simd.o \
 	str.o \
 	stream.o \
 	system.o \
 	textconsole.o \
+	threadpool.o \
 	tokenizer.o \
 	translation.o \
 	unzip.o \
@@ -40,6 +42,7 @@ MODULE_OBJS += \
 	cosinetables.o \
 	dct.o \
 	fft.o \
+	fft_simd.o \
 	huffman.o \
 	rdft.o \
 	sinetables.o
@@ -50,5 +53,10 @@ MODULE_OBJS += \
 	recorderfile.o
 endif
 
+ifdef ENABLE_ZONE_PROFILER
+MODULE_OBJS += \
+	profiler.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
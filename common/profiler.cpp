@@ -0,0 +1,221 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/profiler.h"
+
+#ifdef ENABLE_ZONE_PROFILER
+
+#include "common/mutex.h"
+#include "common/stream.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+bool Profiler::_enabled = false;
+
+Profiler::Profiler() : _numThreads(0) {
+	_mutex = g_system->createMutex();
+
+	for (uint i = 0; i < kMaxThreads; i++) {
+		_threads[i].threadId = kNoThread;
+		_threads[i].mutex = 0;
+		_threads[i].events = 0;
+		_threads[i].next = 0;
+		_threads[i].count = 0;
+	}
+}
+
+Profiler::~Profiler() {
+	_enabled = false;
+
+	for (uint i = 0; i < _numThreads; i++) {
+		g_system->deleteMutex(_threads[i].mutex);
+		delete[] _threads[i].events;
+	}
+	g_system->deleteMutex(_mutex);
+}
+
+void Profiler::setEnabled(bool enabled) {
+	_enabled = enabled;
+}
+
+void Profiler::clear() {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _numThreads; i++) {
+		ThreadBuffer &buffer = _threads[i];
+		StackLock bufferLock(buffer.mutex);
+		buffer.next = 0;
+		buffer.count = 0;
+		buffer.zones.clear();
+	}
+}
+
+Profiler::ThreadBuffer *Profiler::getThreadBuffer() {
+	uint32 threadId = g_system->getThreadId();
+
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _numThreads; i++) {
+		if (_threads[i].threadId == threadId)
+			return &_threads[i];
+	}
+
+	if (_numThreads == kMaxThreads)
+		return 0;
+
+	ThreadBuffer &buffer = _threads[_numThreads];
+	buffer.threadId = threadId;
+	buffer.mutex = g_system->createMutex();
+	buffer.events = new Event[kEventsPerThread];
+	buffer.next = 0;
+	buffer.count = 0;
+	_numThreads++;
+	return &buffer;
+}
+
+void Profiler::addEvent(const ProfileZone &zone, uint64 start, uint64 end) {
+	ThreadBuffer *buffer = getThreadBuffer();
+	if (!buffer)
+		return;
+
+	uint64 duration = end > start ? end - start : 0;
+
+	StackLock lock(buffer->mutex);
+
+	Event &event = buffer->events[buffer->next];
+	event.zone = &zone;
+	event.start = start;
+	event.duration = (uint32)MIN<uint64>(duration, 0xFFFFFFFF);
+	buffer->next = (buffer->next + 1) % kEventsPerThread;
+	if (buffer->count < kEventsPerThread)
+		buffer->count++;
+
+	// Threads only enter a few zones, a linear search is enough
+	uint i = 0;
+	while (i < buffer->zones.size() && buffer->zones[i].zone != &zone)
+		i++;
+
+	if (i == buffer->zones.size()) {
+		ThreadZone added = { &zone, { zone.name, 0, 0, 0, 0 } };
+		buffer->zones.push_back(added);
+	}
+
+	ZoneStats &stats = buffer->zones[i].stats;
+	if (stats.count == 0 || duration < stats.minMicros)
+		stats.minMicros = duration;
+	if (duration > stats.maxMicros)
+		stats.maxMicros = duration;
+	stats.totalMicros += duration;
+	stats.count++;
+}
+
+void Profiler::getStats(Array<ZoneStats> &stats) {
+	StackLock lock(_mutex);
+
+	Array<const ProfileZone *> zones;
+	stats.clear();
+	for (uint i = 0; i < _numThreads; i++) {
+		ThreadBuffer &buffer = _threads[i];
+		StackLock bufferLock(buffer.mutex);
+
+		for (uint j = 0; j < buffer.zones.size(); j++) {
+			const ThreadZone &thread = buffer.zones[j];
+
+			uint k = 0;
+			while (k < zones.size() && zones[k] != thread.zone)
+				k++;
+
+			if (k == zones.size()) {
+				zones.push_back(thread.zone);
+				stats.push_back(thread.stats);
+				continue;
+			}
+
+			ZoneStats &zone = stats[k];
+			zone.minMicros = MIN(zone.minMicros, thread.stats.minMicros);
+			zone.maxMicros = MAX(zone.maxMicros, thread.stats.maxMicros);
+			zone.totalMicros += thread.stats.totalMicros;
+			zone.count += thread.stats.count;
+		}
+	}
+}
+
+String Profiler::formatStats(const ZoneStats &stats) {
+	double average = stats.count ? (double)stats.totalMicros / stats.count : 0.0;
+	return String::format("%-24s %7u  min %8.3f  avg %8.3f  max %8.3f ms", stats.name, stats.count,
+	                      stats.minMicros / 1000.0, average / 1000.0, stats.maxMicros / 1000.0);
+}
+
+static String escapeJSON(const char *str) {
+	String escaped;
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			escaped += '\\';
+		escaped += *str;
+	}
+	return escaped;
+}
+
+uint Profiler::exportTrace(WriteStream &stream) {
+	StackLock lock(_mutex);
+
+	// Write the times relative to the oldest buffered event. The offsets
+	// are 64 bit, written as doubles, which are exact up to 2^53 us.
+	uint64 origin = 0;
+	bool haveOrigin = false;
+	for (uint i = 0; i < _numThreads; i++) {
+		ThreadBuffer &buffer = _threads[i];
+		StackLock bufferLock(buffer.mutex);
+		uint first = (buffer.next + kEventsPerThread - buffer.count) % kEventsPerThread;
+		for (uint j = 0; j < buffer.count; j++) {
+			const Event &event = buffer.events[(first + j) % kEventsPerThread];
+			if (!haveOrigin || event.start < origin) {
+				origin = event.start;
+				haveOrigin = true;
+			}
+		}
+	}
+
+	uint written = 0;
+	stream.writeString("{\"traceEvents\":[");
+	for (uint i = 0; i < _numThreads; i++) {
+		ThreadBuffer &buffer = _threads[i];
+		StackLock bufferLock(buffer.mutex);
+		uint first = (buffer.next + kEventsPerThread - buffer.count) % kEventsPerThread;
+		for (uint j = 0; j < buffer.count; j++) {
+			const Event &event = buffer.events[(first + j) % kEventsPerThread];
+			stream.writeString(String::format("%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.0f,\"dur\":%u}",
+			                                  written ? "," : "", escapeJSON(event.zone->name).c_str(), buffer.threadId,
+			                                  (double)(event.start - origin), event.duration));
+			written++;
+		}
+	}
+	stream.writeString("\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	return written;
+}
+
+} // End of namespace Common
+
+#endif // ENABLE_ZONE_PROFILER
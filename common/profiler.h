@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef ENABLE_ZONE_PROFILER
+
+#include "common/array.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * A named section of code timed by the profiler. PROFILE_ZONE() declares
+ * one static zone per call site, which identifies it in the statistics.
+ */
+struct ProfileZone {
+	const char *name;
+};
+
+/**
+ * Collects the time spent in the profiling zones.
+ *
+ * Each thread entering zones gets its own ring buffer keeping its most
+ * recent events, for the trace export, as well as the per zone totals
+ * since the last clear(), for the statistics. A thread only holds the
+ * profiler mutex while looking up its buffer, and records under the
+ * buffer's own mutex, so the threads seldom wait for each other. The
+ * profiler is disabled by default, and then costs a test per zone.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	/** Number of events kept per thread. */
+	static const uint kEventsPerThread = 8192;
+	/** Number of threads recorded, the events of any further thread are ignored. */
+	static const uint kMaxThreads = 32;
+
+	struct ZoneStats {
+		const char *name;
+		uint32 count;
+		uint64 minMicros;
+		uint64 maxMicros;
+		uint64 totalMicros;
+	};
+
+	static bool isEnabled() { return _enabled; }
+
+	/** Start or stop recording the zones. Stopping keeps the recorded data. */
+	void setEnabled(bool enabled);
+
+	/** Forget all the recorded events and statistics. */
+	void clear();
+
+	/** Record that the calling thread spent the given time in a zone. */
+	void addEvent(const ProfileZone &zone, uint64 start, uint64 end);
+
+	/** Get the statistics of the zones entered since the last clear(). */
+	void getStats(Array<ZoneStats> &stats);
+
+	/** Format the statistics of a zone as one line, times in milliseconds. */
+	static String formatStats(const ZoneStats &stats);
+
+	/**
+	 * Write the buffered events in the Chrome trace event format, which
+	 * can be loaded in chrome://tracing.
+	 * @return the number of events written
+	 */
+	uint exportTrace(WriteStream &stream);
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	Profiler();
+	~Profiler();
+
+	struct Event {
+		const ProfileZone *zone;
+		uint32 duration;
+		uint64 start;
+	};
+
+	struct ThreadZone {
+		const ProfileZone *zone;
+		ZoneStats stats;
+	};
+
+	struct ThreadBuffer {
+		uint32 threadId;
+		OSystem::MutexRef mutex;
+		Event *events;
+		uint next;  ///< Position of the next event in the ring
+		uint count; ///< Number of valid events in the ring
+		Array<ThreadZone> zones; ///< In the order they were first entered
+	};
+
+	ThreadBuffer *getThreadBuffer();
+
+	static bool _enabled;
+
+	/** Thread id of the unused buffers. */
+	static const uint32 kNoThread = 0xFFFFFFFF;
+
+	/**
+	 * Protects the list of buffers, and the readers of all the buffers.
+	 * The buffers are never removed, so a thread can keep using its own
+	 * once it has found it.
+	 */
+	OSystem::MutexRef _mutex;
+	ThreadBuffer _threads[kMaxThreads];
+	uint _numThreads;
+};
+
+/** Times its enclosing scope, as the zone given to the constructor. */
+class ProfileScope {
+public:
+	explicit ProfileScope(const ProfileZone &zone) : _zone(zone), _active(Profiler::isEnabled()) {
+		if (_active)
+			_start = g_system->getMicros();
+	}
+
+	~ProfileScope() {
+		if (_active)
+			Profiler::instance().addEvent(_zone, _start, g_system->getMicros());
+	}
+
+private:
+	const ProfileZone &_zone;
+	bool _active;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+/**
+ * Time the rest of the enclosing scope as a zone of the given name, which
+ * must be a string literal. Compiles to nothing without the zone profiler.
+ */
+#define PROFILE_ZONE(name) \
+	static const Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__) = { name }; \
+	Common::ProfileScope PROFILE_ZONE_CONCAT(profileScope, __LINE__)(PROFILE_ZONE_CONCAT(profileZone, __LINE__))
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+
+#endif // ENABLE_ZONE_PROFILER
+
+#endif
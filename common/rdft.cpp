@@ -25,6 +25,7 @@
 // Copyright (c) 2009 Alex Converse <alex dot converse at gmail dot com>
 
 #include "common/rdft.h"
+#include "common/fft_simd.h"
 
 namespace Common {
 
@@ -68,7 +69,7 @@ void RDFT::calc(float *data) {
 	data[1] = ev.re - data[1];
 
 	int i;
-	for (i = 1; i < (n >> 2); i++) {
+	for (i = rdftTwiddleSIMD(data, n, _tCos, _tSin, k1, k2); i < (n >> 2); i++) {
 		int i1 = 2 * i;
 		int i2 = n - i1;
 
@@ -97,4 +98,9 @@ void RDFT::calc(float *data) {
 
 }
 
+void RDFT::calc(float **data, uint count) {
+	for (uint i = 0; i < count; i++)
+		calc(data[i]);
+}
+
 } // End of namespace Common
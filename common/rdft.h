@@ -94,6 +94,9 @@ public:
 
 	void calc(float *data);
 
+	/** Transform several buffers, for example one for each audio channel. */
+	void calc(float **data, uint count);
+
 private:
 	int _bits;
 	int _inverse;
@@ -700,7 +700,9 @@ void PlaybackFile::checkRecordedMD5() {
 	}
 	uint32 seconds = g_system->getMillis(true) / 1000;
 	String screenTime = String::format("%.2d:%.2d:%.2d", seconds / 3600 % 24, seconds / 60 % 60, seconds % 60);
-	if (memcmp(savedMD5, currentMD5, 16) != 0) {
+	bool match = (memcmp(savedMD5, currentMD5, 16) == 0);
+	g_eventRec.benchmarkCheckpoint(currentMD5, match);
+	if (!match) {
 		debugC(1, kDebugLevelEventRec, "playback:action=\"Check screenshot\" time=%s result = fail", screenTime.c_str());
 		warning("Recorded and current screenshots are different");
 	} else {
@@ -0,0 +1,56 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/simd.h"
+
+namespace Common {
+
+static bool detectSIMD() {
+#if defined(SCUMMVM_SSE2)
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_cpu_supports("sse2");
+#else
+	return true;
+#endif
+#elif defined(SCUMMVM_NEON)
+	// NEON code is only compiled in when the compiler was told the target
+	// has it (-mfpu=neon, or always on AArch64).
+	return true;
+#else
+	return false;
+#endif
+}
+
+// -1 until the CPU has been probed, then 0 or 1
+static int s_simdEnabled = -1;
+
+bool hasSIMD() {
+	if (s_simdEnabled < 0)
+		s_simdEnabled = detectSIMD() ? 1 : 0;
+	return s_simdEnabled != 0;
+}
+
+void setSIMDEnabled(bool enabled) {
+	s_simdEnabled = (enabled && detectSIMD()) ? 1 : 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef COMMON_SIMD_H
+#define COMMON_SIMD_H
+
+#include "common/scummsys.h"
+
+/**
+ * @file
+ * Compile time and run time detection of the vector instruction sets used
+ * by the SIMD code paths (YUV conversion, video codecs, audio mixing...).
+ *
+ * SCUMMVM_SSE2 is defined when the compiler targets x86 with SSE2 and
+ * SCUMMVM_NEON when it targets ARM with NEON. Code using them must still
+ * call Common::hasSIMD() before taking a vectorized path, and must keep a
+ * scalar implementation producing identical results.
+ */
+
+#if !defined(DISABLE_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define SCUMMVM_SSE2
+		#include <emmintrin.h>
+	#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+		#define SCUMMVM_NEON
+		#include <arm_neon.h>
+	#endif
+#endif
+
+namespace Common {
+
+/**
+ * Check whether the vectorized code paths may be used: they have been
+ * compiled in, the CPU supports them and they have not been disabled
+ * with setSIMDEnabled().
+ */
+bool hasSIMD();
+
+/**
+ * Enable or disable the vectorized code paths at run time. They are
+ * enabled by default when supported; disabling them is mostly useful to
+ * compare them against the scalar code.
+ */
+void setSIMDEnabled(bool enabled);
+
+} // End of namespace Common
+
+#endif
@@ -975,6 +975,13 @@ public:
 	*/
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for measuring short durations. Its
+	 * origin is unspecified, and it is never recorded by the event recorder.
+	 * The default implementation only has the precision of getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1093,6 +1100,69 @@ public:
 	//@}
 
 
+	/**
+	 * @name Worker threads
+	 * Optional support for running work on other threads, for example to
+	 * decode several video planes at once or to write savegames in the
+	 * background. Backends which cannot provide threads keep the default
+	 * implementations: createThread() then returns 0, and the callers (see
+	 * Common::ThreadPool) do the work on the calling thread instead.
+	 *
+	 * Threads started this way must not call any other OSystem method than
+	 * the mutex and condition ones, getMillis(), getMicros() and
+	 * getThreadId().
+	 */
+	//@{
+
+	typedef struct OpaqueThread *ThreadRef;
+	typedef struct OpaqueCondition *ConditionRef;
+
+	/** Entry point of a worker thread. */
+	typedef int (*ThreadProc)(void *param);
+
+	/**
+	 * Start a new thread running proc(param).
+	 * @return the newly created thread, or 0 if threads are not supported.
+	 */
+	virtual ThreadRef createThread(ThreadProc proc, void *param) { return 0; }
+
+	/**
+	 * Wait for the given thread to return from its entry point, and free it.
+	 * @param thread	the thread to wait for.
+	 */
+	virtual void joinThread(ThreadRef thread) {}
+
+	/**
+	 * Create a new condition variable.
+	 * @return the newly created condition, or 0 if threads are not supported.
+	 */
+	virtual ConditionRef createCondition() { return 0; }
+
+	/**
+	 * Atomically unlock the mutex and wait for the condition to be
+	 * signaled, then lock the mutex again. The mutex must be locked
+	 * exactly once by the calling thread.
+	 */
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex) {}
+
+	/** Wake up one thread waiting on the condition. */
+	virtual void signalCondition(ConditionRef cond) {}
+
+	/** Wake up all the threads waiting on the condition. */
+	virtual void broadcastCondition(ConditionRef cond) {}
+
+	/** Delete the given condition. No thread may be waiting on it. */
+	virtual void deleteCondition(ConditionRef cond) {}
+
+	/**
+	 * Return an identifier of the calling thread, unique among the running
+	 * threads. Always 0 if threads are not supported.
+	 */
+	virtual uint32 getThreadId() { return 0; }
+
+	//@}
+
+
 
 	/** @name Sound */
 	//@{
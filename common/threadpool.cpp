@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/threadpool.h"
+
+namespace Common {
+
+ThreadPool::ThreadPool(uint numWorkers) : _pendingJobs(0), _quit(false), _jobQueued(0), _jobsDone(0) {
+	_mutex = g_system->createMutex();
+
+	if (numWorkers == 0)
+		return;
+
+	_jobQueued = g_system->createCondition();
+	_jobsDone = g_system->createCondition();
+	if (!_jobQueued || !_jobsDone)
+		return;
+
+	for (uint i = 0; i < numWorkers; i++) {
+		OSystem::ThreadRef thread = g_system->createThread(workerProc, this);
+		if (!thread)
+			break;
+		_workers.push_back(thread);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	waitForJobs();
+
+	g_system->lockMutex(_mutex);
+	_quit = true;
+	if (_jobQueued)
+		g_system->broadcastCondition(_jobQueued);
+	g_system->unlockMutex(_mutex);
+
+	for (uint i = 0; i < _workers.size(); i++)
+		g_system->joinThread(_workers[i]);
+
+	if (_jobQueued)
+		g_system->deleteCondition(_jobQueued);
+	if (_jobsDone)
+		g_system->deleteCondition(_jobsDone);
+	g_system->deleteMutex(_mutex);
+}
+
+void ThreadPool::addJob(JobProc proc, void *data) {
+	if (_workers.empty()) {
+		proc(data);
+		return;
+	}
+
+	Job job;
+	job.proc = proc;
+	job.data = data;
+
+	g_system->lockMutex(_mutex);
+	_jobs.push(job);
+	_pendingJobs++;
+	g_system->signalCondition(_jobQueued);
+	g_system->unlockMutex(_mutex);
+}
+
+void ThreadPool::waitForJobs() {
+	if (_workers.empty())
+		return;
+
+	g_system->lockMutex(_mutex);
+	while (_pendingJobs > 0) {
+		if (!_jobs.empty())
+			runJob();
+		else
+			g_system->waitCondition(_jobsDone, _mutex);
+	}
+	g_system->unlockMutex(_mutex);
+}
+
+bool ThreadPool::hasPendingJobs() {
+	g_system->lockMutex(_mutex);
+	bool pending = _pendingJobs > 0;
+	g_system->unlockMutex(_mutex);
+	return pending;
+}
+
+void ThreadPool::runJob() {
+	Job job = _jobs.pop();
+
+	g_system->unlockMutex(_mutex);
+	job.proc(job.data);
+	g_system->lockMutex(_mutex);
+
+	if (--_pendingJobs == 0)
+		g_system->broadcastCondition(_jobsDone);
+}
+
+int ThreadPool::workerProc(void *param) {
+	ThreadPool *pool = (ThreadPool *)param;
+
+	g_system->lockMutex(pool->_mutex);
+	while (true) {
+		while (pool->_jobs.empty() && !pool->_quit)
+			g_system->waitCondition(pool->_jobQueued, pool->_mutex);
+
+		if (pool->_jobs.empty())
+			break;
+
+		pool->runJob();
+	}
+	g_system->unlockMutex(pool->_mutex);
+
+	return 0;
+}
+
+} // End of namespace Common
@@ -0,0 +1,100 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/queue.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * A fixed set of worker threads running jobs from a shared queue.
+ *
+ * Jobs are plain function pointers with a user data pointer. They run in
+ * no particular order, so jobs queued together must not depend on each
+ * other; use waitForJobs() to order batches of jobs.
+ *
+ * When the backend does not support threads, the pool has no worker and
+ * addJob() runs the job right away on the calling thread, so code using
+ * the pool doesn't need a separate serial path.
+ */
+class ThreadPool : NonCopyable {
+public:
+	typedef void (*JobProc)(void *data);
+
+	/**
+	 * Start the worker threads.
+	 * @param numWorkers	the number of threads to start
+	 */
+	explicit ThreadPool(uint numWorkers);
+
+	/**
+	 * Wait for all the queued jobs to complete, then stop the workers.
+	 */
+	~ThreadPool();
+
+	/** Return the number of worker threads, 0 if running jobs synchronously. */
+	uint getNumWorkers() const { return _workers.size(); }
+
+	/**
+	 * Queue a job. It runs on the first available worker, or immediately
+	 * if the pool has no worker.
+	 */
+	void addJob(JobProc proc, void *data);
+
+	/**
+	 * Wait until every job queued so far has completed. The calling thread
+	 * runs queued jobs itself while waiting.
+	 */
+	void waitForJobs();
+
+	/** Check whether some queued jobs have not completed yet. */
+	bool hasPendingJobs();
+
+private:
+	struct Job {
+		JobProc proc;
+		void *data;
+	};
+
+	static int workerProc(void *param);
+
+	/** Run the next queued job, with _mutex locked. */
+	void runJob();
+
+	Array<OSystem::ThreadRef> _workers;
+	Queue<Job> _jobs;
+	uint _pendingJobs; ///< Queued and running jobs
+	bool _quit;
+
+	OSystem::MutexRef _mutex;
+	OSystem::ConditionRef _jobQueued;
+	OSystem::ConditionRef _jobsDone;
+};
+
+} // End of namespace Common
+
+#endif
@@ -42,6 +42,7 @@
 #include "engines/grim/emi/skeleton.h"
 #include "engines/grim/emi/costume/emiskel_component.h"
 
+#include "common/algorithm.h"
 #include "common/foreach.h"
 
 namespace Grim {
@@ -107,10 +108,15 @@ Actor::Actor() :
 		_shadowArray[i].dontNegate = false;
 		_shadowArray[i].shadowMask = NULL;
 		_shadowArray[i].shadowMaskSize = 0;
+		_shadowArray[i].maskSetup = -1;
+		_shadowArray[i].userData = NULL;
 	}
+
+	_lightSelection = new LightSelection();
 }
 
 Actor::~Actor() {
+	delete _lightSelection;
 	if (_shadowArray) {
 		clearShadowPlanes();
 		delete[] _shadowArray;
@@ -120,6 +126,7 @@ Actor::~Actor() {
 		_costumeStack.pop_back();
 	}
 	g_grim->immediatelyRemoveActor(this);
+	g_grim->getActorIndex()->remove(this);
 
 	if (_cleanBuffer) {
 		g_driver->delBuffer(_cleanBuffer);
@@ -428,6 +435,7 @@ bool Actor::restoreState(SaveGame *savedState) {
 		}
 	}
 
+	updateCollisionIndex();
 	return true;
 }
 
@@ -459,6 +467,7 @@ void Actor::setPos(const Math::Vector3d &position) {
 	if (_followBoxes) {
 		g_grim->getCurrSet()->findClosestSector(_pos, NULL, &_pos);
 	}
+	updateCollisionIndex();
 }
 
 Math::Vector3d Actor::actorForward() const {
@@ -553,14 +562,6 @@ void Actor::walkTo(const Math::Vector3d &p) {
 			Common::List<PathNode *> openList;
 			Common::List<PathNode *> closedList;
 
-			PathNode *start = new PathNode;
-			start->parent = NULL;
-			start->pos = _pos;
-			start->dist = 0.f;
-			start->cost = 0.f;
-			openList.push_back(start);
-			currSet->findClosestSector(_pos, &start->sect, NULL);
-
 			Common::List<Sector *> sectors;
 			for (int i = 0; i < currSet->getSectorCount(); ++i) {
 				Sector *s = currSet->getSectorBase(i);
@@ -570,6 +571,20 @@ void Actor::walkTo(const Math::Vector3d &p) {
 				}
 			}
 
+			// A node is created at most once per sector, plus the start one,
+			// so the nodes never move while the search holds pointers to them.
+			Common::Array<PathNode> nodes;
+			nodes.reserve(sectors.size() + 1);
+
+			nodes.push_back(PathNode());
+			PathNode *start = &nodes.back();
+			start->parent = NULL;
+			start->pos = _pos;
+			start->dist = 0.f;
+			start->cost = 0.f;
+			openList.push_back(start);
+			currSet->findClosestSector(_pos, &start->sect, NULL);
+
 			Sector *endSec = NULL;
 			currSet->findClosestSector(_destPos, &endSec, NULL);
 
@@ -654,7 +669,9 @@ void Actor::walkTo(const Math::Vector3d &p) {
 							n->dist = (n->pos - _destPos).getMagnitude();
 						}
 					} else {
-						n = new PathNode;
+						assert(nodes.size() < sectors.size() + 1);
+						nodes.push_back(PathNode());
+						n = &nodes.back();
 						n->parent = node;
 						n->sect = s;
 						n->pos = best;
@@ -664,13 +681,6 @@ void Actor::walkTo(const Math::Vector3d &p) {
 					}
 				}
 			} while (!openList.empty());
-
-			for (Common::List<PathNode *>::iterator j = closedList.begin(); j != closedList.end(); ++j) {
-				delete *j;
-			}
-			for (Common::List<PathNode *>::iterator j = openList.begin(); j != openList.end(); ++j) {
-				delete *j;
-			}
 		}
 
 		_path.push_front(_destPos);
@@ -706,10 +716,29 @@ void Actor::moveTo(const Math::Vector3d &pos) {
 	}
 
 	Math::Vector3d v = pos - _pos;
-	foreach (Actor *a, g_grim->getActiveActors()) {
-		handleCollisionWith(a, mode, &v);
+	Math::Vector2d center;
+	float extent;
+	if (getCollisionBounds(mode, center, extent)) {
+		// Test each actor once, but look for new ones when a collision moved
+		// the destination.
+		Common::Array<Actor *> candidates, tested;
+		bool moved = true;
+		while (moved) {
+			moved = false;
+			Math::Vector2d dest(center.getX() + v.x(), center.getY() + v.y());
+			candidates.clear();
+			findCollisionCandidates(dest - Math::Vector2d(extent, extent), dest + Math::Vector2d(extent, extent), true, candidates);
+			for (uint i = 0; i < candidates.size() && !moved; ++i) {
+				Actor *a = candidates[i];
+				if (Common::find(tested.begin(), tested.end(), a) != tested.end())
+					continue;
+				tested.push_back(a);
+				moved = handleCollisionWith(a, mode, &v);
+			}
+		}
 	}
 	_pos += v;
+	updateCollisionIndex();
 }
 
 void Actor::walkForward() {
@@ -734,6 +763,7 @@ void Actor::walkForward() {
 
 		_pos += forwardVec * dist;
 		_walkedCur = true;
+		updateCollisionIndex();
 		return;
 	}
 
@@ -831,7 +861,7 @@ void Actor::walkForward() {
 			turnDir = -1;
 		}
 		if (ei.angleWithEdge > _reflectionAngle)
-			return;
+			break;
 
 		ei.angleWithEdge += (float)1.0f;
 		turnTo(0, _moveYaw + ei.angleWithEdge * turnDir, 0, true);
@@ -844,6 +874,7 @@ void Actor::walkForward() {
 				break;
 		}
 	}
+	updateCollisionIndex();
 }
 
 Math::Vector3d Actor::getSimplePuckVector() const {
@@ -1237,6 +1268,7 @@ void Actor::pushCostume(const char *n) {
 		_costumeStack.push_front(newCost);
 	else
 		_costumeStack.push_back(newCost);
+	updateCollisionIndex();
 }
 
 void Actor::setColormap(const char *map) {
@@ -1270,6 +1302,7 @@ void Actor::popCostume() {
 			freeCostumeChore(_costumeStack.back(), &_talkChore[i]);
 		delete _costumeStack.back();
 		_costumeStack.pop_back();
+		updateCollisionIndex();
 
 		if (_costumeStack.empty()) {
 			Debug::debug(Debug::Actors, "Popped (freed) the last costume for an actor.\n");
@@ -1325,6 +1358,7 @@ void Actor::updateWalk() {
 		if (_path.empty()) {
 			_walking = false;
 			_pos = destPos;
+			updateCollisionIndex();
 // It seems that we need to allow an already active turning motion to
 // continue or else turning actors away from barriers won't work right
 			_turning = false;
@@ -1337,6 +1371,7 @@ void Actor::updateWalk() {
 	dir = destPos - _pos;
 	dir.normalize();
 	_pos += dir * walkAmt;
+	updateCollisionIndex();
 }
 
 void Actor::update(uint frameTime) {
@@ -1346,6 +1381,7 @@ void Actor::update(uint frameTime) {
 	// walkboxes, etc.
 	if (_followBoxes && !_walking) {
 		set->findClosestSector(_pos, NULL, &_pos);
+		updateCollisionIndex();
 	}
 
 	if (g_grim->getGameType() == GType_MONKEY4) {
@@ -1496,7 +1532,9 @@ void Actor::update(uint frameTime) {
 			costumeMarkerCallback(marker);
 		}
 	}
+}
 
+void Actor::animate() {
 	Costume *c = getCurrentCostume();
 	if (c) {
 		c->animate();
@@ -1543,9 +1581,7 @@ void Actor::draw() {
 		for (int l = 0; l < MAX_SHADOWS; l++) {
 			if (!_shadowArray[l].active)
 				continue;
-			g_driver->setShadow(&_shadowArray[l]);
-			g_driver->drawShadowPlanes();
-			g_driver->setShadow(NULL);
+			updateShadowMask(&_shadowArray[l], g_grim->getCurrSet());
 		}
 	}
 
@@ -1553,7 +1589,7 @@ void Actor::draw() {
 	Math::Vector3d absPos = getWorldPos();
 	const Math::Quaternion rot = getRotationQuat();
 	if (!_costumeStack.empty()) {
-		g_grim->getCurrSet()->setupLights(absPos);
+		g_grim->getCurrSet()->setupLights(absPos, _lightSelection);
 		if (g_grim->getGameType() == GType_GRIM) {
 			Costume *costume = _costumeStack.back();
 			drawCostume(costume, absPos, rot);
@@ -1635,10 +1671,56 @@ void Actor::addShadowPlane(const char *n, Set *scene, int shadowId) {
 		// the scenes' sectors are deleted while they are still keeped by the actors.
 		Plane p = { scene->getName(), new Sector(*sector) };
 		_shadowArray[shadowId].planeList.push_back(p);
+		clearShadowMasks(&_shadowArray[shadowId]);
 		g_grim->flagRefreshShadowMask(true);
 	}
 }
 
+void Actor::updateShadowMask(Shadow *shadow, Set *set) {
+	// The mask only depends on the planes and on the camera, so it must not be drawn
+	// again each time the refresh flag is raised, nor when going back to a setup.
+	const int setup = set->getSetup();
+	if (shadow->shadowMask && shadow->maskSetup == setup && shadow->maskSetName == set->getName())
+		return;
+
+	if (shadow->shadowMask && shadow->maskSetup != -1) {
+		ShadowMask m = { shadow->maskSetName, shadow->maskSetup, shadow->shadowMask, shadow->shadowMaskSize };
+		shadow->maskCache.push_front(m);
+		shadow->shadowMask = NULL;
+		shadow->shadowMaskSize = 0;
+	}
+
+	const uint maxCachedMasks = 4;
+	uint cached = 0;
+	for (Common::List<ShadowMask>::iterator i = shadow->maskCache.begin(); i != shadow->maskCache.end(); ) {
+		if (!shadow->shadowMask && i->setup == setup && i->setName == set->getName()) {
+			shadow->shadowMask = i->mask;
+			shadow->shadowMaskSize = i->maskSize;
+			i = shadow->maskCache.erase(i);
+		} else if (++cached > maxCachedMasks) {
+			delete[] i->mask;
+			i = shadow->maskCache.erase(i);
+		} else {
+			++i;
+		}
+	}
+
+	if (!shadow->shadowMask || shadow->maskSetup == -1) {
+		g_driver->setShadow(shadow);
+		g_driver->drawShadowPlanes();
+		g_driver->setShadow(NULL);
+	}
+	shadow->maskSetName = set->getName();
+	shadow->maskSetup = setup;
+}
+
+void Actor::clearShadowMasks(Shadow *shadow) {
+	for (Common::List<ShadowMask>::iterator i = shadow->maskCache.begin(); i != shadow->maskCache.end(); ++i)
+		delete[] i->mask;
+	shadow->maskCache.clear();
+	shadow->maskSetup = -1;
+}
+
 bool Actor::shouldDrawShadow(int shadowId) {
 	Shadow *shadow = &_shadowArray[shadowId];
 	if (!shadow->active)
@@ -1708,6 +1790,8 @@ void Actor::clearShadowPlanes() {
 		shadow->shadowMask = NULL;
 		shadow->active = false;
 		shadow->dontNegate = false;
+		clearShadowMasks(shadow);
+		g_driver->destroyShadow(shadow);
 	}
 }
 
@@ -1722,6 +1806,7 @@ void Actor::putInSet(const Common::String &set) {
 	}
 
 	g_grim->invalidateActiveActorsList();
+	updateCollisionIndex();
 }
 
 bool Actor::isInSet(const Common::String &set) const {
@@ -1751,10 +1836,65 @@ bool Actor::stopMumbleChore() {
 
 void Actor::setCollisionMode(CollisionMode mode) {
 	_collisionMode = mode;
+	updateCollisionIndex();
 }
 
 void Actor::setCollisionScale(float scale) {
 	_collisionScale = scale;
+	updateCollisionIndex();
+}
+
+void Actor::setInOverworld(bool inOverworld) {
+	_inOverworld = inOverworld;
+	updateCollisionIndex();
+}
+
+void Actor::updateCollisionIndex() {
+	g_grim->getActorIndex()->update(this);
+}
+
+bool Actor::getCollisionBounds(CollisionMode mode, Math::Vector2d &center, float &extent) const {
+	Costume *costume = getCurrentCostume();
+	Model *model = costume ? costume->getModel() : NULL;
+	if (!model)
+		return false;
+
+	Math::Vector3d p = _pos + model->_insertOffset;
+	center = Math::Vector2d(p.x(), p.y());
+
+	if (mode == CollisionBox) {
+		// The box is scaled around its center, then rotated around the actor.
+		Math::Vector2d offset(model->_bboxPos.x() + model->_bboxSize.x() / 2.f, model->_bboxPos.y() + model->_bboxSize.y() / 2.f);
+		Math::Vector2d halfSize(model->_bboxSize.x() / 2.f, model->_bboxSize.y() / 2.f);
+		extent = offset.getMagnitude() + halfSize.getMagnitude() * fabsf(_collisionScale);
+	} else {
+		extent = fabsf(model->_radius * _collisionScale);
+	}
+	// Leave some room for the rounding errors of the collision tests
+	extent *= 1.01f;
+	return true;
+}
+
+static bool compareActorId(const Actor *a, const Actor *b) {
+	return a->getId() < b->getId();
+}
+
+void Actor::findCollisionCandidates(const Math::Vector2d &min, const Math::Vector2d &max, bool activeOnly, Common::Array<Actor *> &candidates) const {
+	ActorIndex *index = g_grim->getActorIndex();
+	if (!activeOnly) {
+		index->findCandidates(_setName, min.getX(), min.getY(), max.getX(), max.getY(), candidates);
+	} else {
+		// The same actors as GrimEngine::buildActiveActorsList()
+		Set *set = g_grim->getCurrSet();
+		bool normalMode = g_grim->getMode() == GrimEngine::NormalMode && set;
+		if (normalMode)
+			index->findCandidates(set->getName(), min.getX(), min.getY(), max.getX(), max.getY(), candidates);
+		foreach (Actor *a, index->getOverworldActors()) {
+			if (!normalMode || !a->isInSet(set->getName()))
+				candidates.push_back(a);
+		}
+	}
+	Common::sort(candidates.begin(), candidates.end(), compareActorId);
 }
 
 Math::Vector3d Actor::handleCollisionTo(const Math::Vector3d &from, const Math::Vector3d &pos) const {
@@ -1762,10 +1902,25 @@ Math::Vector3d Actor::handleCollisionTo(const Math::Vector3d &from, const Math::
 		return pos;
 	}
 
+	// Test each actor once, but look for new ones when a collision moved
+	// the destination.
 	Math::Vector3d p = pos;
-	foreach (Actor *a, Actor::getPool()) {
-		if (a != this && a->isInSet(_setName) && a->isVisible()) {
-			p = a->getTangentPos(from, p);
+	Common::Array<Actor *> candidates, tested;
+	bool moved = true;
+	while (moved) {
+		moved = false;
+		Math::Vector2d min(MIN(from.x(), p.x()), MIN(from.y(), p.y()));
+		Math::Vector2d max(MAX(from.x(), p.x()), MAX(from.y(), p.y()));
+		candidates.clear();
+		findCollisionCandidates(min, max, false, candidates);
+		for (uint i = 0; i < candidates.size() && !moved; ++i) {
+			Actor *a = candidates[i];
+			if (a == this || !a->isVisible() || Common::find(tested.begin(), tested.end(), a) != tested.end())
+				continue;
+			tested.push_back(a);
+			Math::Vector3d tangent = a->getTangentPos(from, p);
+			moved = tangent.x() != p.x() || tangent.y() != p.y() || tangent.z() != p.z();
+			p = tangent;
 		}
 	}
 	return p;
@@ -1967,6 +2122,8 @@ bool Actor::handleCollisionWith(Actor *actor, CollisionMode mode, Math::Vector3d
 }
 
 void Actor::costumeMarkerCallback(int marker) {
+	g_grim->finishActorsAnimation();
+
 	LuaObjects objects;
 	objects.add(this);
 	objects.add(marker);
@@ -1975,6 +2132,8 @@ void Actor::costumeMarkerCallback(int marker) {
 }
 
 void Actor::collisionHandlerCallback(Actor *other) const {
+	g_grim->finishActorsAnimation();
+
 	LuaObjects objects;
 	objects.add(this);
 	objects.add(other);
@@ -2166,4 +2325,138 @@ void Actor::Chore::restoreState(SaveGame *savedState, Actor *actor) {
 	_chore = savedState->readLESint32();
 }
 
+bool ActorIndex::isBefore(const Entry &a, const Entry &b) {
+	if (a.x != b.x)
+		return a.x < b.x;
+	return a.actor->getId() < b.actor->getId();
+}
+
+uint ActorIndex::findEntry(const Common::Array<Entry> &entries, float x, int id) const {
+	uint first = 0, last = entries.size();
+	while (first < last) {
+		uint mid = (first + last) / 2;
+		const Entry &e = entries[mid];
+		if (e.x < x || (e.x == x && e.actor->getId() < id))
+			first = mid + 1;
+		else
+			last = mid;
+	}
+	assert(first < entries.size() && entries[first].actor->getId() == id);
+	return first;
+}
+
+void ActorIndex::removeEntry(int id) {
+	LocationMap::iterator it = _locations.find(id);
+	if (it == _locations.end())
+		return;
+
+	SetMap::iterator set = _sets.find(it->_value.set);
+	Common::Array<Entry> &entries = set->_value.entries;
+	entries.remove_at(findEntry(entries, it->_value.x, id));
+	if (entries.empty())
+		_sets.erase(set);
+	_locations.erase(it);
+}
+
+void ActorIndex::update(Actor *actor) {
+	// Actor::getTangentPos() uses the sphere of the actor, and
+	// Actor::handleCollisionWith() its box when it is in box mode and the
+	// moving actor is not.
+	Entry entry;
+	Math::Vector2d center;
+	bool collides = actor->getCollisionMode() != Actor::CollisionOff &&
+	                actor->getCollisionBounds(Actor::CollisionSphere, center, entry.extent);
+	if (collides && actor->getCollisionMode() == Actor::CollisionBox) {
+		float boxExtent;
+		actor->getCollisionBounds(Actor::CollisionBox, center, boxExtent);
+		entry.extent = MAX(entry.extent, boxExtent);
+	}
+	entry.x = center.getX();
+	entry.y = center.getY();
+	entry.actor = actor;
+
+	removeOverworld(actor);
+	if (collides && actor->isInOverworld())
+		_overworld.push_back(actor);
+
+	int id = actor->getId();
+	LocationMap::iterator it = _locations.find(id);
+	if (it != _locations.end() && collides && it->_value.set == actor->getSetName()) {
+		// Still in the same set, so move the entry to its new place. The
+		// actors only move a little each time, so this is short.
+		SetEntries &set = _sets[it->_value.set];
+		Common::Array<Entry> &entries = set.entries;
+		uint i = findEntry(entries, it->_value.x, id);
+		while (i > 0 && isBefore(entry, entries[i - 1])) {
+			entries[i] = entries[i - 1];
+			--i;
+		}
+		while (i + 1 < entries.size() && isBefore(entries[i + 1], entry)) {
+			entries[i] = entries[i + 1];
+			++i;
+		}
+		entries[i] = entry;
+		set.maxExtent = MAX(set.maxExtent, entry.extent);
+		it->_value.x = entry.x;
+		return;
+	}
+
+	removeEntry(id);
+	if (!collides)
+		return;
+
+	SetEntries &set = _sets[actor->getSetName()];
+	Common::Array<Entry> &entries = set.entries;
+	uint i = 0;
+	while (i < entries.size() && isBefore(entries[i], entry))
+		++i;
+	entries.insert_at(i, entry);
+	set.maxExtent = MAX(set.maxExtent, entry.extent);
+
+	Location &location = _locations[id];
+	location.set = actor->getSetName();
+	location.x = entry.x;
+}
+
+void ActorIndex::removeOverworld(Actor *actor) {
+	for (uint i = 0; i < _overworld.size(); ++i) {
+		if (_overworld[i] == actor) {
+			_overworld.remove_at(i);
+			return;
+		}
+	}
+}
+
+void ActorIndex::remove(Actor *actor) {
+	removeEntry(actor->getId());
+	removeOverworld(actor);
+}
+
+void ActorIndex::findCandidates(const Common::String &set, float minX, float minY, float maxX, float maxY, Common::Array<Actor *> &candidates) const {
+	SetMap::const_iterator it = _sets.find(set);
+	if (it == _sets.end())
+		return;
+
+	// Only the actors with their center this close on X can reach the rectangle
+	const Common::Array<Entry> &entries = it->_value.entries;
+	float start = minX - it->_value.maxExtent;
+	float end = maxX + it->_value.maxExtent;
+
+	uint first = 0, last = entries.size();
+	while (first < last) {
+		uint mid = (first + last) / 2;
+		if (entries[mid].x < start)
+			first = mid + 1;
+		else
+			last = mid;
+	}
+
+	for (uint i = first; i < entries.size() && entries[i].x <= end; ++i) {
+		const Entry &e = entries[i];
+		if (e.x + e.extent >= minX && e.x - e.extent <= maxX &&
+		    e.y + e.extent >= minY && e.y - e.extent <= maxY)
+			candidates.push_back(e.actor);
+	}
+}
+
 } // end of namespace Grim
@@ -23,9 +23,12 @@
 #ifndef GRIM_ACTOR_H
 #define GRIM_ACTOR_H
 
+#include "common/hash-str.h"
+
 #include "engines/grim/pool.h"
 #include "engines/grim/object.h"
 #include "engines/grim/color.h"
+#include "math/vector2d.h"
 #include "math/vector3d.h"
 #include "math/angle.h"
 #include "math/quat.h"
@@ -39,6 +42,7 @@ class LipSync;
 class Font;
 class Set;
 struct Joint;
+struct LightSelection;
 
 struct Plane {
 	Common::String setName;
@@ -49,6 +53,13 @@ typedef Common::List<Plane> SectorListType;
 
 #define MAX_SHADOWS 5
 
+struct ShadowMask {
+	Common::String setName;
+	int setup;
+	byte *mask;
+	int maskSize;
+};
+
 struct Shadow {
 	Common::String name;
 	Math::Vector3d pos;
@@ -57,6 +68,13 @@ struct Shadow {
 	int shadowMaskSize;
 	bool active;
 	bool dontNegate;
+	// The set and setup shadowMask was drawn for (-1 if unknown), and the masks
+	// of the setups seen before, which stay valid until the planes change.
+	Common::String maskSetName;
+	int maskSetup;
+	Common::List<ShadowMask> maskCache;
+	// Renderer specific data, freed by GfxBase::destroyShadow()
+	void *userData;
 };
 
 /**
@@ -470,6 +488,12 @@ public:
 
 	void setFollowBoxes(bool follow) { _followBoxes = follow; }
 	void update(uint frameTime);
+	/**
+	 * Evaluate the pose of the current costume and turn the head. Only the
+	 * costumes of this actor are touched, so this may run on another thread
+	 * once update() is done, see GrimEngine::luaUpdate().
+	 */
+	void animate();
 	/**
 	 * Check if the actor is still talking. If it is returns true, otherwise false.
 	 */
@@ -496,6 +520,14 @@ public:
 	void setCollisionScale(float scale);
 
 	bool handleCollisionWith(Actor *actor, CollisionMode mode, Math::Vector3d *vec) const;
+	/**
+	 * Get the center of the actor on the XY plane used by the collisions, and
+	 * how far from it the actor can collide in the given mode. Returns false
+	 * if the actor has no model to collide with.
+	 */
+	bool getCollisionBounds(CollisionMode mode, Math::Vector2d &center, float &extent) const;
+	CollisionMode getCollisionMode() const { return _collisionMode; }
+	const Common::String &getSetName() const { return _setName; }
 
 	static void saveStaticState(SaveGame *state);
 	static void restoreStaticState(SaveGame *state);
@@ -515,8 +547,8 @@ public:
 	 */
 	Math::Vector3d actorUp() const;
 
-	void setInOverworld(bool inOverworld) { _inOverworld = inOverworld; }
-	bool isInOverworld() { return _inOverworld; }
+	void setInOverworld(bool inOverworld);
+	bool isInOverworld() const { return _inOverworld; }
 
 	void setGlobalAlpha(float alpha) { _globalAlpha = alpha; }
 	void setAlphaMode(AlphaMode mode) { _alphaMode = mode; }
@@ -534,10 +566,23 @@ public:
 
 private:
 	void costumeMarkerCallback(int marker);
+	/**
+	 * Get the actors which may collide with something within the rectangle,
+	 * sorted by id. These are the active actors if activeOnly is set, or the
+	 * actors in the set of this one otherwise.
+	 */
+	void findCollisionCandidates(const Math::Vector2d &min, const Math::Vector2d &max, bool activeOnly, Common::Array<Actor *> &candidates) const;
+	void updateCollisionIndex();
 	void collisionHandlerCallback(Actor *other) const;
 	void updateWalk();
 	void addShadowPlane(const char *n, Set *scene, int shadowId);
 	bool shouldDrawShadow(int shadowId);
+	/**
+	 * Make the mask of the shadow the one of the current setup, drawing it
+	 * only if it is not cached already.
+	 */
+	void updateShadowMask(Shadow *shadow, Set *set);
+	void clearShadowMasks(Shadow *shadow);
 	void stopTalking();
 	bool stopMumbleChore();
 	void drawCostume(Costume *costume, const Math::Vector3d &absPos, const Math::Quaternion &rot);
@@ -679,10 +724,67 @@ private:
 	int _sortOrder;
 
 	bool _shadowActive;
+	// The lights used for the last draw, kept by Set::setupLights()
+	LightSelection *_lightSelection;
 	int _cleanBuffer;
 	bool _drawnToClean;
 };
 
+/**
+ * @class ActorIndex
+ *
+ * @short Keeps the actors which can collide sorted along the X axis, for
+ * each set, so that only the ones near a moving actor are tested.
+ *
+ * The actors must call update() whenever they move, or their set, costume
+ * or collision settings change.
+ */
+class ActorIndex {
+public:
+	void update(Actor *actor);
+	void remove(Actor *actor);
+
+	/**
+	 * Append the actors of the set which may collide with something within
+	 * the rectangle.
+	 */
+	void findCandidates(const Common::String &set, float minX, float minY, float maxX, float maxY, Common::Array<Actor *> &candidates) const;
+	/** The actors in the overworld which can collide, in no particular order. */
+	const Common::Array<Actor *> &getOverworldActors() const { return _overworld; }
+
+private:
+	struct Entry {
+		float x, y;
+		float extent;
+		Actor *actor;
+	};
+
+	struct SetEntries {
+		SetEntries() : maxExtent(0.f) {}
+
+		/** Sorted by x, then by actor id. */
+		Common::Array<Entry> entries;
+		/** Not less than the extent of any entry. */
+		float maxExtent;
+	};
+
+	struct Location {
+		Common::String set;
+		float x;
+	};
+
+	static bool isBefore(const Entry &a, const Entry &b);
+	uint findEntry(const Common::Array<Entry> &entries, float x, int id) const;
+	void removeEntry(int id);
+	void removeOverworld(Actor *actor);
+
+	typedef Common::HashMap<Common::String, SetEntries> SetMap;
+	typedef Common::HashMap<int, Location> LocationMap;
+	SetMap _sets;
+	LocationMap _locations;
+	Common::Array<Actor *> _overworld;
+};
+
 } // end of namespace Grim
 
 #endif
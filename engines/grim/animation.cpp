@@ -34,6 +34,8 @@ Animation::Animation(const Common::String &keyframe, AnimManager *manager, int p
 		_manager(manager), _priority1(pr1), _priority2(pr2), _paused(true),
 		_active(false), _time(-1), _fade(1.f), _fadeMode(None) {
 	_keyframe = g_resourceloader->getKeyframe(keyframe);
+	if (_keyframe)
+		_cursors.resize(_keyframe->getNumJoints());
 }
 
 Animation::~Animation() {
@@ -248,54 +250,78 @@ void AnimManager::removeAnimation(const Animation *anim) {
 }
 
 void AnimManager::animate(ModelNode *hier, int numNodes) {
-	// Apply animation to each hierarchy node separately.
+	// Blend the animations one at a time into the pose of all the nodes, instead of
+	// blending all the animations of a node before going to the next node, and only
+	// copy the final pose to the nodes.
+	_pose.resize(numNodes);
+	_layersPose.resize(numNodes);
+	_totalWeight.resize(numNodes);
+	_remainingWeight.resize(numNodes);
 	for (int i = 0; i < numNodes; i++) {
-		Math::Vector3d tempPos;
-		Math::Angle tempYaw = 0.0f, tempPitch = 0.0f, tempRoll = 0.0f;
-		float totalWeight = 0.0f;
-		float remainingWeight = 1.0f;
-		int currPriority = -1;
-
-		// The animations are layered so that animations with a higher priority
-		// are played regardless of the blend weights of lower priority animations.
-		// The highest priority layer gets as much weight as it wants, while the
-		// next layer gets the remaining amount and so on.
-		for (Common::List<AnimationEntry>::iterator j = _activeAnims.begin(); j != _activeAnims.end(); ++j) {
-			if (currPriority != j->_priority) {
-				currPriority = j->_priority;
-				remainingWeight *= 1 - totalWeight;
-				if (remainingWeight <= 0.0f)
-					break;
+		_pose._pos[i] = hier[i]._animPos;
+		_pose._pitch[i] = hier[i]._animPitch;
+		_pose._yaw[i] = hier[i]._animYaw;
+		_pose._roll[i] = hier[i]._animRoll;
+		_layersPose._pos[i].set(0, 0, 0);
+		_layersPose._pitch[i] = 0.0f;
+		_layersPose._yaw[i] = 0.0f;
+		_layersPose._roll[i] = 0.0f;
+		_totalWeight[i] = 0.0f;
+		_remainingWeight[i] = 1.0f;
+	}
+
+	// The animations are layered so that animations with a higher priority
+	// are played regardless of the blend weights of lower priority animations.
+	// The highest priority layer gets as much weight as it wants, while the
+	// next layer gets the remaining amount and so on. A node is done once it
+	// has no weight left.
+	int currPriority = -1;
+	for (Common::List<AnimationEntry>::iterator j = _activeAnims.begin(); j != _activeAnims.end(); ++j) {
+		if (currPriority != j->_priority) {
+			currPriority = j->_priority;
+			for (int i = 0; i < numNodes; i++) {
+				if (_remainingWeight[i] <= 0.0f)
+					continue;
+				_remainingWeight[i] *= 1 - _totalWeight[i];
+				if (_remainingWeight[i] <= 0.0f)
+					continue;
 
 				float weightFactor = 1.0f;
-				if (totalWeight > 1.0f) {
-					weightFactor = 1.0f / totalWeight;
+				if (_totalWeight[i] > 1.0f) {
+					weightFactor = 1.0f / _totalWeight[i];
 				}
-				tempPos += hier[i]._animPos * weightFactor;
-				tempYaw += hier[i]._animYaw * weightFactor;
-				tempPitch += hier[i]._animPitch * weightFactor;
-				tempRoll += hier[i]._animRoll * weightFactor;
-				hier[i]._animPos.set(0, 0, 0);
-				hier[i]._animYaw = 0.0f;
-				hier[i]._animPitch = 0.0f;
-				hier[i]._animRoll = 0.0f;
-				totalWeight = 0.0f;
+				_layersPose._pos[i] += _pose._pos[i] * weightFactor;
+				_layersPose._yaw[i] += _pose._yaw[i] * weightFactor;
+				_layersPose._pitch[i] += _pose._pitch[i] * weightFactor;
+				_layersPose._roll[i] += _pose._roll[i] * weightFactor;
+				_pose._pos[i].set(0, 0, 0);
+				_pose._yaw[i] = 0.0f;
+				_pose._pitch[i] = 0.0f;
+				_pose._roll[i] = 0.0f;
+				_totalWeight[i] = 0.0f;
 			}
+		}
 
-			float time = j->_anim->_time / 1000.0f;
-			float weight = j->_anim->_fade * remainingWeight;
-			if (j->_anim->_keyframe->animate(hier, i, time, weight, j->_tagged))
-				totalWeight += j->_anim->_fade;
+		Animation *anim = j->_anim;
+		float time = anim->_time / 1000.0f;
+		for (int i = 0; i < numNodes; i++) {
+			if (_remainingWeight[i] <= 0.0f)
+				continue;
+			float weight = anim->_fade * _remainingWeight[i];
+			if (anim->_keyframe->animate(_pose, hier, i, time, weight, j->_tagged, anim->_cursors.begin()))
+				_totalWeight[i] += anim->_fade;
 		}
+	}
 
+	for (int i = 0; i < numNodes; i++) {
 		float weightFactor = 1.0f;
-		if (totalWeight > 1.0f) {
-			weightFactor = 1.0f / totalWeight;
+		if (_totalWeight[i] > 1.0f) {
+			weightFactor = 1.0f / _totalWeight[i];
 		}
-		hier[i]._animPos = hier[i]._animPos * weightFactor + tempPos;
-		hier[i]._animYaw = hier[i]._animYaw * weightFactor + tempYaw;
-		hier[i]._animPitch = hier[i]._animPitch * weightFactor + tempPitch;
-		hier[i]._animRoll = hier[i]._animRoll * weightFactor + tempRoll;
+		hier[i]._animPos = _pose._pos[i] * weightFactor + _layersPose._pos[i];
+		hier[i]._animYaw = _pose._yaw[i] * weightFactor + _layersPose._yaw[i];
+		hier[i]._animPitch = _pose._pitch[i] * weightFactor + _layersPose._pitch[i];
+		hier[i]._animRoll = _pose._roll[i] * weightFactor + _layersPose._roll[i];
 	}
 }
 
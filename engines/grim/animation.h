@@ -72,6 +72,8 @@ private:
 	RepeatMode _repeatMode;
 	FadeMode _fadeMode;
 	int _fadeLength;
+	/** The keyframe entry of each joint at the last animated frame */
+	Common::Array<int> _cursors;
 
 	friend class AnimManager;
 };
@@ -93,6 +95,10 @@ private:
 	};
 
 	Common::List<AnimationEntry> _activeAnims;
+
+	// The blending state of each node, see animate()
+	AnimPose _pose, _layersPose;
+	Common::Array<float> _totalWeight, _remainingWeight;
 };
 
 }
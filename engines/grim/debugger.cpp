@@ -24,6 +24,8 @@
 #include "engines/grim/md5check.h"
 #include "engines/grim/grim.h"
 
+#include "graphics/tinygl/zgl.h"
+
 namespace Grim {
 
 Debugger::Debugger() :
@@ -32,6 +34,7 @@ Debugger::Debugger() :
 	DCmd_Register("check_gamedata", WRAP_METHOD(Debugger, cmd_checkFiles));
 	DCmd_Register("lua_do", WRAP_METHOD(Debugger, cmd_lua_do));
 	DCmd_Register("emi_jump", WRAP_METHOD(Debugger, cmd_emi_jump));
+	DCmd_Register("tinygl_alloc", WRAP_METHOD(Debugger, cmd_tinygl_alloc));
 }
 
 Debugger::~Debugger() {
@@ -76,4 +79,28 @@ bool Debugger::cmd_emi_jump(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::showProfilerOverlay(bool show) {
+	g_grim->setShowProfiler(show);
+	return true;
+}
+
+bool Debugger::cmd_tinygl_alloc(int argc, const char **argv) {
+	TinyGL::GLAllocStats *stats = TinyGL::gl_get_alloc_stats();
+
+	DebugPrintf("TinyGL allocations:\n");
+	DebugPrintf("  heap: %d allocs, %d frees\n", stats->mallocs, stats->frees);
+	DebugPrintf("  pools: %d allocs, %d frees\n", stats->pool_allocs, stats->pool_frees);
+	DebugPrintf("  arenas: %d allocs, %d blocks, %d bytes in use\n", stats->arena_allocs, stats->arena_blocks, stats->arena_bytes);
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		// The arena blocks and bytes are live figures, not counters
+		stats->mallocs = stats->frees = 0;
+		stats->pool_allocs = stats->pool_frees = 0;
+		stats->arena_allocs = 0;
+		DebugPrintf("Counters reset.\n");
+	}
+
+	return true;
+}
+
 }
@@ -35,6 +35,10 @@ public:
 	bool cmd_checkFiles(int argc, const char **argv);
 	bool cmd_lua_do(int argc, const char **argv);
 	bool cmd_emi_jump(int argc, const char **argv);
+	bool cmd_tinygl_alloc(int argc, const char **argv);
+
+protected:
+	virtual bool showProfilerOverlay(bool show);
 };
 
 }
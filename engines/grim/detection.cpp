@@ -482,6 +482,10 @@ SaveStateList GrimMetaEngine::listSaves(const char *target) const {
 	Common::String targetString(target);
 	Common::String pattern = targetString.hasPrefix("monkey4") ? "efmi*.gsv" : "grim*.gsv";
 
+	// From the global main menu, the game may still be writing a savegame
+	if (g_grim)
+		g_grim->waitForSavegameWrites();
+
 	filenames = saveFileMan->listSavefiles(pattern);
 
 	SaveStateList saveList;
@@ -24,6 +24,7 @@
 
 #include "common/stream.h"
 #include "common/mutex.h"
+#include "common/threadpool.h"
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
 #include "audio/mixer.h"
@@ -40,6 +41,12 @@
 
 #define NUM_CHANNELS 32
 
+// How much of a predicted music track is decoded ahead of time
+#define MUSIC_PREROLL_MS 250
+// Duration of the crossfade between two music states
+#define MUSIC_CROSSFADE_MS 500
+#define MAX_PREROLLED_MUSIC 2
+
 namespace Grim {
 
 class SoundTrack;
@@ -50,12 +57,16 @@ EMISound::EMISound() {
 		_channels[i] = NULL;
 	}
 	_music = NULL;
+	_musicState = 0;
+	_prerollPool = new Common::ThreadPool(1);
 	initMusicTable();
 }
 
 EMISound::~EMISound() {
 	freeAllChannels();
-	delete _music;
+	freeAllMusic();
+	flushStack();
+	delete _prerollPool;
 	delete[] _channels;
 	delete[] _musicTable;
 }
@@ -157,22 +168,15 @@ bool EMISound::initTrack(const Common::String &filename, SoundTrack *track) {
 	}
 }
 
-void EMISound::setMusicState(int stateId) {
-	if (_music) {
-		delete _music;
-		_music = NULL;
-	}
-	if (stateId == 0)
-		return;
+bool EMISound::getMusicFilename(int stateId, Common::String &filename) const {
 	if (_musicTable == NULL) {
 		warning("No music table loaded");
-		return;
+		return false;
 	}
 	if (_musicTable[stateId]._id != stateId) {
 		warning("Attempted to play track #%d, not found in music table!", stateId);
-		return;
+		return false;
 	}
-	Common::String filename;
 	if (g_grim->getGamePlatform() == Common::kPlatformPS2) {
 		warning("PS2 doesn't have musictable yet %d ignored, just playing 1195.SCX", stateId);
 		// So, we just rig up the menu-song hardcoded for now, as a test of the SCX-code.
@@ -180,12 +184,144 @@ void EMISound::setMusicState(int stateId) {
 	} else {
 		filename = _musicTable[stateId]._filename;
 	}
-	_music = createEmptyMusicTrack();
+	return true;
+}
 
-	warning("Loading music: %s", filename.c_str());
-	if (initTrack(filename, _music)) {
-		_music->play();
+SoundTrack *EMISound::openMusicTrack(const Common::String &filename) {
+	SoundTrack *music = createEmptyMusicTrack();
+	if (!initTrack(filename, music)) {
+		delete music;
+		return NULL;
 	}
+	music->prepareStream();
+	return music;
+}
+
+void EMISound::prerollJob(void *data) {
+	SoundTrack *track = (SoundTrack *)data;
+	track->preroll(MUSIC_PREROLL_MS);
+}
+
+void EMISound::prerollMusic(int stateId) {
+	if (stateId <= 0 || !_musicTable || _musicTable[stateId]._id != stateId)
+		return;
+
+	for (uint i = 0; i < _prerolledMusic.size(); i++) {
+		if (_prerolledMusic[i]._stateId == stateId)
+			return;
+	}
+
+	// Drop the oldest prediction
+	if (_prerolledMusic.size() >= MAX_PREROLLED_MUSIC) {
+		_prerollPool->waitForJobs();
+		delete _prerolledMusic[0]._track;
+		_prerolledMusic.remove_at(0);
+	}
+
+	Common::String filename;
+	if (!getMusicFilename(stateId, filename))
+		return;
+
+	// The file is opened here, the resource loader isn't thread safe
+	SoundTrack *track = openMusicTrack(filename);
+	if (!track)
+		return;
+
+	PrerolledTrack prerolled;
+	prerolled._stateId = stateId;
+	prerolled._track = track;
+	_prerolledMusic.push_back(prerolled);
+
+	_prerollPool->addJob(&prerollJob, track);
+}
+
+SoundTrack *EMISound::takePrerolledMusic(int stateId) {
+	for (uint i = 0; i < _prerolledMusic.size(); i++) {
+		if (_prerolledMusic[i]._stateId == stateId) {
+			SoundTrack *track = _prerolledMusic[i]._track;
+			_prerolledMusic.remove_at(i);
+
+			// The preroll is short, it's almost always done by now
+			_prerollPool->waitForJobs();
+			return track;
+		}
+	}
+	return NULL;
+}
+
+void EMISound::fadeOutMusic(SoundTrack *track) {
+	track->fade(0, MUSIC_CROSSFADE_MS);
+	_fadingMusic.push_back(track);
+}
+
+void EMISound::freeFadedMusic() {
+	for (uint i = 0; i < _fadingMusic.size(); ) {
+		SoundTrack *track = _fadingMusic[i];
+		if (!track->getHandle() || !g_system->getMixer()->isSoundHandleActive(*track->getHandle()) || track->isFadedOut()) {
+			delete track;
+			_fadingMusic.remove_at(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void EMISound::freeAllMusic() {
+	delete _music;
+	_music = NULL;
+	_musicState = 0;
+
+	for (uint i = 0; i < _fadingMusic.size(); i++)
+		delete _fadingMusic[i];
+	_fadingMusic.clear();
+
+	_prerollPool->waitForJobs();
+	for (uint i = 0; i < _prerolledMusic.size(); i++)
+		delete _prerolledMusic[i]._track;
+	_prerolledMusic.clear();
+}
+
+void EMISound::setMusicState(int stateId) {
+	freeFadedMusic();
+
+	int previousState = _musicState;
+	bool crossfade = _music != NULL;
+	if (_music) {
+		fadeOutMusic(_music);
+		_music = NULL;
+	}
+	_musicState = 0;
+	if (stateId == 0)
+		return;
+
+	Common::String filename;
+	if (!getMusicFilename(stateId, filename))
+		return;
+
+	SoundTrack *music = takePrerolledMusic(stateId);
+	if (!music) {
+		warning("Loading music: %s", filename.c_str());
+		music = openMusicTrack(filename);
+	}
+
+	if (music) {
+		if (crossfade) {
+			music->fade(0, 0);
+			music->fade(Audio::Mixer::kMaxChannelVolume, MUSIC_CROSSFADE_MS);
+		}
+		music->play();
+		_music = music;
+		_musicState = stateId;
+	}
+
+	// Predict the next music states: going back to the previous
+	// state, and the state which followed this one the last time
+	if (previousState)
+		_musicTransitions[previousState] = stateId;
+	if (_musicTransitions.contains(stateId) && _musicTransitions[stateId] != stateId)
+		prerollMusic(_musicTransitions[stateId]);
+	if (previousState != stateId)
+		prerollMusic(previousState);
 }
 
 uint32 EMISound::getMsPos(int stateId) {
@@ -332,15 +468,25 @@ void EMISound::pushStateToStack() {
 		_music->pause();
 	_stateStack.push(_music);
 	_music = NULL;
+	_musicState = 0;
 }
 
 void EMISound::popStateFromStack() {
-	delete _music;
+	freeFadedMusic();
+
+	bool crossfade = _music != NULL;
+	if (_music)
+		fadeOutMusic(_music);
 
 	//even pop state from stack if music isn't set
 	_music = _stateStack.pop();
+	_musicState = 0;
 
 	if (_music) {
+		if (crossfade) {
+			_music->fade(0, 0);
+			_music->fade(Audio::Mixer::kMaxChannelVolume, MUSIC_CROSSFADE_MS);
+		}
 		_music->pause();
 	}
 }
@@ -355,7 +501,7 @@ void EMISound::flushStack() {
 void EMISound::restoreState(SaveGame *savedState) {
 	// Clear any current music
 	flushStack();
-	setMusicState(0);
+	freeAllMusic();
 	freeAllChannels();
 	// Actually load:
 	savedState->beginSection('SOUN');
@@ -364,8 +510,8 @@ void EMISound::restoreState(SaveGame *savedState) {
 	uint32 stackSize = savedState->readLEUint32();
 	for (uint32 i = 0; i < stackSize; i++) {
 		Common::String soundName = savedState->readString();
-		SoundTrack *track = createEmptyMusicTrack();
-		if (initTrack(soundName, track)) {
+		SoundTrack *track = openMusicTrack(soundName);
+		if (track) {
 			track->play();
 			track->pause();
 			_stateStack.push(track);
@@ -376,9 +522,9 @@ void EMISound::restoreState(SaveGame *savedState) {
 	// Currently playing music:
 	uint32 hasActiveTrack = savedState->readLEUint32();
 	if (hasActiveTrack) {
-		_music = createEmptyMusicTrack();
 		Common::String soundName = savedState->readString();
-		if (initTrack(soundName, _music)) {
+		_music = openMusicTrack(soundName);
+		if (_music) {
 			_music->play();
 		} else {
 			error("Couldn't reopen %s", soundName.c_str());
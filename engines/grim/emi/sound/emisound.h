@@ -23,9 +23,15 @@
 #ifndef GRIM_MSS_H
 #define GRIM_MSS_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 #include "common/stack.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Grim {
 
 class SoundTrack;
@@ -51,6 +57,20 @@ class EMISound {
 	Common::String _musicPrefix;
 	Common::Stack<SoundTrack*> _stateStack;
 
+	struct PrerolledTrack {
+		int _stateId;
+		SoundTrack *_track;
+	};
+
+	int _musicState;
+	// Music tracks opened ahead of time, their start is decoded on a worker
+	Common::Array<PrerolledTrack> _prerolledMusic;
+	Common::ThreadPool *_prerollPool;
+	// Tracks being faded out after a music change
+	Common::Array<SoundTrack *> _fadingMusic;
+	// The last state which followed each music state
+	Common::HashMap<int, int> _musicTransitions;
+
 	void removeItem(SoundTrack *item);
 	int32 getFreeChannel();
 	int32 getChannelByName(const Common::String &name);
@@ -82,6 +102,15 @@ private:
 	void freeAllChannels();
 	bool initTrack(const Common::String &filename, SoundTrack *track);
 	SoundTrack *createEmptyMusicTrack() const;
+
+	bool getMusicFilename(int stateId, Common::String &filename) const;
+	SoundTrack *openMusicTrack(const Common::String &filename);
+	void prerollMusic(int stateId);
+	SoundTrack *takePrerolledMusic(int stateId);
+	void fadeOutMusic(SoundTrack *track);
+	void freeFadedMusic();
+	void freeAllMusic();
+	static void prerollJob(void *data);
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include "common/mutex.h"
 #include "common/str.h"
+#include "common/util.h"
 #include "common/stream.h"
 #include "audio/mixer.h"
 #include "audio/audiostream.h"
@@ -29,8 +30,115 @@
 
 namespace Grim {
 
+/**
+ * Plays the stream of a track, starting with samples decoded ahead
+ * of time, and applies fades to it with a per sample volume ramp.
+ */
+class TrackStream : public Audio::AudioStream {
+public:
+	TrackStream(Audio::AudioStream *parent) :
+			_parent(parent), _preroll(NULL), _prerollSize(0), _prerollPos(0),
+			_volume(kFullVolume), _volumeStep(0), _fadeTarget(kFullVolume), _fadeFrames(0), _fadedOut(false) {
+	}
+
+	~TrackStream() {
+		delete[] _preroll;
+		delete _parent;
+	}
+
+	void preroll(uint32 ms) {
+		Common::StackLock lock(_mutex);
+
+		int samples = (int)(ms * _parent->getRate() / 1000) * (_parent->isStereo() ? 2 : 1);
+
+		delete[] _preroll;
+		_preroll = new int16[samples];
+		_prerollSize = _parent->readBuffer(_preroll, samples);
+		_prerollPos = 0;
+	}
+
+	void fade(int volume, uint32 ms) {
+		Common::StackLock lock(_mutex);
+
+		int32 target = volume * kFullVolume / Audio::Mixer::kMaxChannelVolume;
+		_fadeFrames = ms * _parent->getRate() / 1000;
+		if (_fadeFrames == 0) {
+			_volume = target;
+			_volumeStep = 0;
+		} else {
+			_volumeStep = (target - _volume) / (int32)_fadeFrames;
+		}
+		_fadeTarget = target;
+		_fadedOut = false;
+	}
+
+	bool isFadedOut() const {
+		Common::StackLock lock(_mutex);
+		return _fadedOut;
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		Common::StackLock lock(_mutex);
+
+		if (_fadedOut)
+			return 0;
+
+		int samples = MIN(numSamples, _prerollSize - _prerollPos);
+		if (samples > 0) {
+			memcpy(buffer, _preroll + _prerollPos, samples * sizeof(int16));
+			_prerollPos += samples;
+		} else {
+			samples = 0;
+		}
+		if (samples < numSamples)
+			samples += _parent->readBuffer(buffer + samples, numSamples - samples);
+
+		if (_volume != kFullVolume || _fadeFrames)
+			applyVolume(buffer, samples);
+
+		return samples;
+	}
+
+	bool isStereo() const { return _parent->isStereo(); }
+	int getRate() const { return _parent->getRate(); }
+	bool endOfData() const { return _fadedOut || (_prerollPos >= _prerollSize && _parent->endOfData()); }
+	bool endOfStream() const { return _fadedOut || (_prerollPos >= _prerollSize && _parent->endOfStream()); }
+
+private:
+	// Volume in 16.16 fixed point
+	static const int32 kFullVolume = 1 << 16;
+
+	void applyVolume(int16 *buffer, int samples) {
+		const int channels = _parent->isStereo() ? 2 : 1;
+
+		for (int i = 0; i + channels <= samples; i += channels) {
+			if (_fadeFrames) {
+				_fadeFrames--;
+				_volume = _fadeFrames ? _volume + _volumeStep : _fadeTarget;
+			}
+			for (int c = 0; c < channels; c++)
+				buffer[i + c] = (int16)(((int32)buffer[i + c] * _volume) >> 16);
+		}
+
+		if (_volume == 0 && !_fadeFrames)
+			_fadedOut = true;
+	}
+
+	mutable Common::Mutex _mutex;
+	Audio::AudioStream *_parent;
+	int16 *_preroll;
+	int _prerollSize;
+	int _prerollPos;
+	int32 _volume;
+	int32 _volumeStep;
+	int32 _fadeTarget;
+	uint32 _fadeFrames;
+	bool _fadedOut;
+};
+
 SoundTrack::SoundTrack() {
 	_stream = NULL;
+	_trackStream = NULL;
 	_handle = NULL;
 	_paused = false;
 	_disposeAfterPlaying = DisposeAfterUse::YES;
@@ -68,6 +176,32 @@ void SoundTrack::pause() {
 	}
 }
 
+void SoundTrack::prepareStream() {
+	if (!_stream || _trackStream)
+		return;
+
+	_trackStream = new TrackStream(_stream);
+	_stream = _trackStream;
+
+	// The fades and isFadedOut() access the stream after the mixer is done
+	// with it, so it is kept until the track is deleted
+	_disposeAfterPlaying = DisposeAfterUse::NO;
+}
+
+void SoundTrack::preroll(uint32 ms) {
+	if (_trackStream)
+		_trackStream->preroll(ms);
+}
+
+void SoundTrack::fade(int volume, uint32 ms) {
+	if (_trackStream)
+		_trackStream->fade(volume, ms);
+}
+
+bool SoundTrack::isFadedOut() const {
+	return _trackStream && _trackStream->isFadedOut();
+}
+
 void SoundTrack::stop() {
 	if (_handle)
 		g_system->getMixer()->stopHandle(*_handle);
@@ -36,6 +36,8 @@ namespace Audio {
 
 namespace Grim {
 
+class TrackStream;
+
 /**
  * @class Super-class for the different codecs used in EMI
  */
@@ -43,6 +45,7 @@ class SoundTrack {
 protected:
 	Common::String _soundName;
 	Audio::AudioStream *_stream;
+	TrackStream *_trackStream;
 	Audio::SoundHandle *_handle;
 	Audio::Mixer::SoundType _soundType;
 	DisposeAfterUse::Flag _disposeAfterPlaying;
@@ -56,6 +59,24 @@ public:
 	virtual void pause();
 	virtual void stop();
 	Audio::SoundHandle *getHandle() { return _handle; }
+
+	/**
+	 * Wrap the opened stream to allow prerolling and fading it.
+	 * To be called after openSound() and before play().
+	 */
+	void prepareStream();
+	/**
+	 * Decode the beginning of the track ahead of playing it.
+	 * This may run on a worker thread, as long as the track isn't playing.
+	 */
+	void preroll(uint32 ms);
+	/**
+	 * Fade the track to the given volume, between 0 and
+	 * Audio::Mixer::kMaxChannelVolume. The track stops when faded out.
+	 */
+	void fade(int volume, uint32 ms);
+	bool isFadedOut() const;
+
 	Common::String getSoundName();
 	void setSoundName(const Common::String &name);
 };
@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/algorithm.h"
+
 #include "engines/grim/gfx_base.h"
 #include "engines/grim/savegame.h"
 
@@ -27,8 +29,46 @@ namespace Grim {
 
 GfxBase::GfxBase() :
 		_renderBitmaps(true), _renderZBitmaps(true), _shadowModeActive(false),
-		_currentPos(0, 0, 0), _currentQuat(0, 0, 0, 1), _dimLevel(0.0f) {
+		_currentPos(0, 0, 0), _currentQuat(0, 0, 0, 1), _dimLevel(0.0f),
+		_lightSlotsVersion(0), _refreshLightSlots(false) {
+
+}
+
+void GfxBase::setupLights(Light *const *lights, uint count, uint32 version) {
+	_lightSlots.resize(getMaxLights());
+	assert(count <= _lightSlots.size());
+
+	bool refresh = _refreshLightSlots || version != _lightSlotsVersion;
+	_refreshLightSlots = false;
+	_lightSlotsVersion = version;
+
+	// Free the slots of the lights which aren't used anymore
+	for (uint i = 0; i < _lightSlots.size(); i++) {
+		if (!_lightSlots[i])
+			continue;
+
+		if (Common::find(lights, lights + count, _lightSlots[i]) == lights + count) {
+			turnOffLight(i);
+			_lightSlots[i] = NULL;
+		} else if (refresh) {
+			setupLight(_lightSlots[i], i);
+		}
+	}
+
+	// Put the new ones in the free slots
+	for (uint j = 0; j < count; j++) {
+		if (Common::find(_lightSlots.begin(), _lightSlots.end(), lights[j]) != _lightSlots.end())
+			continue;
+
+		uint slot = 0;
+		while (_lightSlots[slot])
+			slot++;
+		_lightSlots[slot] = lights[j];
+		setupLight(lights[j], slot);
+	}
 
+	if (count > 0)
+		enableLights();
 }
 
 void GfxBase::setShadowMode() {
@@ -23,6 +23,8 @@
 #ifndef GRIM_GFX_BASE_H
 #define GRIM_GFX_BASE_H
 
+#include "common/array.h"
+
 #include "math/vector3d.h"
 #include "math/quat.h"
 
@@ -125,6 +127,10 @@ public:
 	bool isShadowModeActive();
 	virtual void setShadowColor(byte r, byte g, byte b) = 0;
 	virtual void getShadowColor(byte *r, byte *g, byte *b) = 0;
+	/**
+	 * Free the data the renderer keeps in Shadow::userData.
+	 */
+	virtual void destroyShadow(Shadow *shadow) { }
 
 	virtual void set3DMode() = 0;
 
@@ -141,6 +147,14 @@ public:
 	virtual void disableLights() = 0;
 	virtual void setupLight(Light *light, int lightId) = 0;
 	virtual void turnOffLight(int lightId) = 0;
+	/** The number of lights the renderer can use at once. */
+	virtual int getMaxLights() const = 0;
+	/**
+	 * Use the given lights, turning off the others. A light which is already
+	 * in a slot stays there, and is only set up again if its data may have
+	 * changed, as told by version, or the camera moved.
+	 */
+	void setupLights(Light *const *lights, uint count, uint32 version);
 
 	virtual void createMaterial(Texture *material, const char *data, const CMap *cmap) = 0;
 	virtual void selectMaterial(const Texture *material) = 0;
@@ -276,6 +290,13 @@ protected:
 	Math::Vector3d _currentPos;
 	Math::Quaternion _currentQuat;
 	float _dimLevel;
+
+	/** The light in each slot of the renderer. */
+	Common::Array<Light *> _lightSlots;
+	/** The version of the lights in the slots. */
+	uint32 _lightSlotsVersion;
+	/** Set when the light positions need to be sent again. */
+	bool _refreshLightSlots;
 };
 
 // Factory-like functions:
@@ -230,6 +230,9 @@ void GfxOpenGL::setupCamera(float fov, float nclip, float fclip, float roll) {
 }
 
 void GfxOpenGL::positionCamera(const Math::Vector3d &pos, const Math::Vector3d &interest, float roll) {
+	// The light positions depend on the camera
+	_refreshLightSlots = true;
+
 	if (g_grim->getGameType() == GType_MONKEY4) {
 		glScaled(1, 1, -1);
 
@@ -722,6 +725,10 @@ void GfxOpenGL::setupLight(Light *light, int lightId) {
 	glEnable(GL_LIGHT0 + lightId);
 }
 
+int GfxOpenGL::getMaxLights() const {
+	return _maxLights;
+}
+
 void GfxOpenGL::turnOffLight(int lightId) {
 	glDisable(GL_LIGHT0 + lightId);
 }
@@ -86,6 +86,7 @@ public:
 	void disableLights();
 	void setupLight(Light *light, int lightId);
 	void turnOffLight(int lightId);
+	int getMaxLights() const;
 
 	void createMaterial(Texture *material, const char *data, const CMap *cmap);
 	void selectMaterial(const Texture *material);
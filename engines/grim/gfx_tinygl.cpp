@@ -55,14 +55,11 @@ public:
 		_last = NULL;
 		_width = 0;
 		_height = 0;
+		TinyGL::gl_arena_init(&_lineArena, kLineArenaBlockSize);
 	}
 	~BlitImage() {
-		Line *temp = _lines;
-		while (temp != NULL) {
-			_lines = temp->next;
-			delete temp;
-			temp = _lines;
-		}
+		// The lines are all released with their arena
+		TinyGL::gl_arena_free(&_lineArena);
 	}
 	void create(const Graphics::PixelBuffer &buf, uint32 transparency, int x, int y, int width, int height) {
 		Graphics::PixelBuffer srcBuf = buf;
@@ -97,7 +94,7 @@ public:
 			return;
 		}
 
-		Line *line = new Line;
+		Line *line = (Line *)TinyGL::gl_arena_alloc(&_lineArena, sizeof(Line));
 
 		line->x = x;
 		line->y = y;
@@ -125,6 +122,11 @@ public:
 	Line *_lines;
 	Line *_last;
 	int _width, _height;
+
+private:
+	static const int kLineArenaBlockSize = 256 * sizeof(Line);
+
+	TinyGL::GLArena _lineArena;
 };
 
 GfxBase *CreateGfxTinyGL() {
@@ -233,12 +235,14 @@ TGLint tgluProject(TGLfloat objx, TGLfloat objy, TGLfloat objz, const TGLfloat m
 
 GfxTinyGL::GfxTinyGL() :
 		_smushWidth(0), _smushHeight(0), _zb(NULL), _alpha(1.f),
-		_bufferId(0) {
+		_bufferId(0), _recordingShadow(false) {
 	g_driver = this;
 	_storedDisplay = NULL;
+	_shadowRecord = new ShadowGeometry();
 }
 
 GfxTinyGL::~GfxTinyGL() {
+	delete _shadowRecord;
 	if (_zb) {
 		delBuffer(1);
 		TinyGL::glClose();
@@ -299,6 +303,9 @@ void GfxTinyGL::setupCamera(float fov, float nclip, float fclip, float roll) {
 }
 
 void GfxTinyGL::positionCamera(const Math::Vector3d &pos, const Math::Vector3d &interest, float roll) {
+	// The light positions depend on the camera
+	_refreshLightSlots = true;
+
 	if (g_grim->getGameType() == GType_MONKEY4) {
 		tglScalef(1.0, 1.0, -1.0);
 
@@ -323,6 +330,9 @@ void GfxTinyGL::clearScreen() {
 
 void GfxTinyGL::flipBuffer() {
 	g_system->updateScreen();
+
+	// Scratch memory only lives for a frame
+	TinyGL::gl_frame_reset();
 }
 
 int GfxTinyGL::genBuffer() {
@@ -566,9 +576,56 @@ void GfxTinyGL::startActorDraw(const Math::Vector3d &pos, float scale, const Mat
 
 	if (depthOnly)
 		tglColorMask(false, false, false, false);
+
+	// Only record the faces of the shadow pass, they are drawn in finishActorDraw()
+	if (_currentShadowArray && g_grim->getGameType() == GType_GRIM) {
+		_recordingShadow = true;
+		_shadowRecord->faces.resize(0);
+		_shadowRecord->vertices.resize(0);
+		_shadowRecord->faceMatrices.resize(0);
+		_shadowRecord->matrices.resize(16);
+		tglGetFloatv(TGL_PROJECTION_MATRIX, &_shadowRecord->matrices[0]);
+	}
+}
+
+void GfxTinyGL::drawShadowGeometry() {
+	ShadowGeometry *cached = (ShadowGeometry *)_currentShadowArray->userData;
+
+	// The same faces with the same matrices, so the pose, the shadow point and
+	// the camera did not change: the projected triangles are still valid.
+	if (cached && cached->faces == _shadowRecord->faces && cached->vertices == _shadowRecord->vertices &&
+	    cached->faceMatrices == _shadowRecord->faceMatrices && cached->matrices == _shadowRecord->matrices) {
+		tglDrawShadowTriangles(cached->triangles);
+		return;
+	}
+
+	ShadowGeometry *geometry = _shadowRecord;
+	_shadowRecord = cached ? cached : new ShadowGeometry();
+	_currentShadowArray->userData = geometry;
+
+	geometry->triangles.resize(0);
+	tglSetShadowCaptureBuf(&geometry->triangles);
+	tglMatrixMode(TGL_MODELVIEW);
+	for (uint i = 0; i < geometry->faces.size(); i++) {
+		const MeshFace *face = geometry->faces[i];
+		const float *vertices = geometry->vertices[i];
+		if (i == 0 || geometry->faceMatrices[i] != geometry->faceMatrices[i - 1])
+			tglLoadMatrixf(&geometry->matrices[geometry->faceMatrices[i] * 16]);
+
+		tglBegin(TGL_POLYGON);
+		for (int j = 0; j < face->_numVertices; j++)
+			tglVertex3fv(const_cast<float *>(vertices + 3 * face->_vertices[j]));
+		tglEnd();
+	}
+	tglSetShadowCaptureBuf(NULL);
 }
 
 void GfxTinyGL::finishActorDraw() {
+	if (_recordingShadow) {
+		_recordingShadow = false;
+		drawShadowGeometry();
+	}
+
 	tglMatrixMode(TGL_MODELVIEW);
 	tglPopMatrix();
 	tglMatrixMode(TGL_PROJECTION);
@@ -636,6 +693,11 @@ void GfxTinyGL::clearShadowMode() {
 	tglDisable(TGL_SHADOW_MODE);
 }
 
+void GfxTinyGL::destroyShadow(Shadow *shadow) {
+	delete (ShadowGeometry *)shadow->userData;
+	shadow->userData = NULL;
+}
+
 void GfxTinyGL::set3DMode() {
 	tglMatrixMode(TGL_MODELVIEW);
 	tglEnable(TGL_DEPTH_TEST);
@@ -693,6 +755,22 @@ void GfxTinyGL::drawEMIModelFace(const EMIModel *model, const EMIMeshFace *face)
 }
 
 void GfxTinyGL::drawModelFace(const MeshFace *face, float *vertices, float *vertNormals, float *textureVerts) {
+	if (_recordingShadow) {
+		TGLfloat modelView[16];
+		tglGetFloatv(TGL_MODELVIEW_MATRIX, modelView);
+
+		Common::Array<float> &matrices = _shadowRecord->matrices;
+		const uint last = matrices.size() - 16;
+		if (memcmp(&matrices[last], modelView, sizeof(modelView)) != 0) {
+			for (int i = 0; i < 16; i++)
+				matrices.push_back(modelView[i]);
+		}
+		_shadowRecord->faces.push_back(face);
+		_shadowRecord->vertices.push_back(vertices);
+		_shadowRecord->faceMatrices.push_back(matrices.size() / 16 - 1);
+		return;
+	}
+
 	tglNormal3fv(const_cast<float *>(face->_normal.getData()));
 	tglBegin(TGL_POLYGON);
 	for (int i = 0; i < face->_numVertices; i++) {
@@ -838,6 +916,10 @@ void GfxTinyGL::setupLight(Light *light, int lightId) {
 	tglEnable(TGL_LIGHT0 + lightId);
 }
 
+int GfxTinyGL::getMaxLights() const {
+	return T_MAX_LIGHTS;
+}
+
 void GfxTinyGL::turnOffLight(int lightId) {
 	tglDisable(TGL_LIGHT0 + lightId);
 }
@@ -1044,7 +1126,7 @@ void GfxTinyGL::createTextObject(TextObject *text) {
 		int width = font->getStringLength(currentLine) + 1;
 		int height = font->getHeight();
 
-		uint8 *_textBitmap = new uint8[height * width];
+		uint8 *_textBitmap = (uint8 *)TinyGL::gl_frame_alloc(height * width);
 		memset(_textBitmap, 0, height * width);
 
 		// Fill bitmap
@@ -1103,8 +1185,6 @@ void GfxTinyGL::createTextObject(TextObject *text) {
 			if (userData[j].y < 0)
 				userData[j].y = 0;
 		}
-
-		delete[] _textBitmap;
 	}
 }
 
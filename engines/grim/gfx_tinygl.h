@@ -66,6 +66,7 @@ public:
 	void clearShadowMode();
 	void setShadowColor(byte r, byte g, byte b);
 	void getShadowColor(byte *r, byte *g, byte *b);
+	void destroyShadow(Shadow *shadow);
 
 	void set3DMode();
 
@@ -82,6 +83,7 @@ public:
 	void disableLights();
 	void setupLight(Light *light, int lightId);
 	void turnOffLight(int lightId);
+	int getMaxLights() const;
 
 	void createMaterial(Texture *material, const char *data, const CMap *cmap);
 	void selectMaterial(const Texture *material);
@@ -138,6 +140,22 @@ private:
 	Common::HashMap<int, TinyGL::Buffer *> _buffers;
 	uint _bufferId;
 
+	/**
+	 * The faces of a shadow pass, with the matrices they are drawn with, and
+	 * the triangles they were rasterized into. The first matrix is the projection.
+	 */
+	struct ShadowGeometry {
+		Common::Array<const MeshFace *> faces;
+		Common::Array<float *> vertices;
+		Common::Array<int> faceMatrices;
+		Common::Array<float> matrices;
+		Common::Array<int> triangles;
+	};
+	ShadowGeometry *_shadowRecord;
+	bool _recordingShadow;
+
+	void drawShadowGeometry();
+
 	void readPixels(int x, int y, int width, int height, uint8 *buffer);
 	void blit(const Graphics::PixelFormat &format, BlitImage *blit, byte *dst, byte *src, int x, int y, int width, int height, bool trans);
 	void blit(const Graphics::PixelFormat &format, BlitImage *blit, byte *dst, byte *src, int dstX, int dstY, int srcX, int srcY, int width, int height, int srcWidth, int srcHeight, bool trans);
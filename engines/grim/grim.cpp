@@ -31,10 +31,13 @@
 #include "common/foreach.h"
 #include "common/fs.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
+#include "common/threadpool.h"
 
 #include "graphics/pixelbuffer.h"
 
 #include "gui/error.h"
+#include "gui/EventRecorder.h"
 #include "gui/gui-manager.h"
 #include "gui/message.h"
 
@@ -73,11 +76,16 @@ GrimEngine *g_grim = NULL;
 GfxBase *g_driver = NULL;
 int g_imuseState = -1;
 
+// Number of worker threads evaluating the poses of the actors
+static const uint kAnimationWorkers = 2;
+
 GrimEngine::GrimEngine(OSystem *syst, uint32 gameFlags, GrimGameType gameType, Common::Platform platform, Common::Language language) :
 		Engine(syst), _currSet(NULL), _selectedActor(NULL) {
 	g_grim = this;
 
 	_debugger = new Debugger();
+	_actorIndex = new ActorIndex();
+	_animationPool = new Common::ThreadPool(kAnimationWorkers);
 	_gameType = gameType;
 	_gameFlags = gameFlags;
 	_gamePlatform = platform;
@@ -101,6 +109,7 @@ GrimEngine::GrimEngine(OSystem *syst, uint32 gameFlags, GrimGameType gameType, C
 	ConfMan.registerDefault("use_arb_shaders", true);
 
 	_showFps = ConfMan.getBool("show_fps");
+	_showProfiler = false;
 
 	_softRenderer = true;
 
@@ -130,6 +139,7 @@ GrimEngine::GrimEngine(OSystem *syst, uint32 gameFlags, GrimGameType gameType, C
 	_refreshDrawNeeded = true;
 	_listFilesIter = NULL;
 	_savedState = NULL;
+	_saveWriter = new SaveGameWriter();
 	_fps[0] = 0;
 	_iris = new Iris();
 	_buildActiveActorsList = false;
@@ -171,7 +181,12 @@ GrimEngine::~GrimEngine() {
 	delete[] _controlsEnabled;
 	delete[] _controlsState;
 
+	// Let the pending savegames be written
+	delete _saveWriter;
+
 	clearPools();
+	delete _actorIndex;
+	delete _animationPool;
 
 	delete LuaBase::instance();
 	if (g_registry) {
@@ -440,6 +455,8 @@ void GrimEngine::playIrisAnimation(Iris::Direction dir, int x, int y, int time)
 }
 
 void GrimEngine::luaUpdate() {
+	PROFILE_ZONE("GrimEngine::luaUpdate");
+
 	if (_savegameLoadRequest || _savegameSaveRequest || _changeHardwareState)
 		return;
 
@@ -456,9 +473,14 @@ void GrimEngine::luaUpdate() {
 		_frameTime = 0;
 	}
 
-	LuaBase::instance()->update(_frameTime, _movieTime);
+	{
+		GUI::BenchmarkScope benchmark(GUI::kBenchmarkScripts);
+		LuaBase::instance()->update(_frameTime, _movieTime);
+	}
 
 	if (_currSet && (_mode == NormalMode || _mode == SmushMode)) {
+		GUI::BenchmarkScope benchmark(GUI::kBenchmarkActors);
+
 		// call updateTalk() before calling update(), since it may modify costumes state, and
 		// the costumes are updated in update().
 		for (Common::List<Actor *>::iterator i = _talkingActors.begin(); i != _talkingActors.end(); ++i) {
@@ -470,13 +492,19 @@ void GrimEngine::luaUpdate() {
 
 		// Update the actors. Do it here so that we are sure to react asap to any change
 		// in the actors state caused by lua.
+		// The update of an actor can move other actors and run Lua code, so it is
+		// done in order here. The pose of an actor only depends on its own costumes,
+		// so it is evaluated on the workers while the next actors are updated, and
+		// finishActorsAnimation() makes Lua see the poses as if done serially.
 		buildActiveActorsList();
 		foreach (Actor *a, _activeActors) {
 			// Note that the actor need not be visible to update chores, for example:
 			// when Manny has just brought Meche back he is offscreen several times
 			// when he needs to perform certain chores
 			a->update(_frameTime);
+			_animationPool->addJob(animateActor, a);
 		}
+		finishActorsAnimation();
 
 		_iris->update(_frameTime);
 
@@ -486,7 +514,17 @@ void GrimEngine::luaUpdate() {
 	}
 }
 
+void GrimEngine::animateActor(void *actor) {
+	static_cast<Actor *>(actor)->animate();
+}
+
+void GrimEngine::finishActorsAnimation() {
+	_animationPool->waitForJobs();
+}
+
 void GrimEngine::updateDisplayScene() {
+	GUI::BenchmarkScope benchmark(GUI::kBenchmarkRender);
+	PROFILE_ZONE("GrimEngine::updateDisplayScene");
 	_doFlip = true;
 
 	if (_mode == SmushMode) {
@@ -606,6 +644,9 @@ void GrimEngine::doFlip() {
 	if (_showFps && _mode != DrawMode)
 		g_driver->drawEmergString(550, 25, _fps, Color(255, 255, 255));
 
+	if (_showProfiler && _mode != DrawMode)
+		drawProfilerOverlay();
+
 	if (_flipEnable)
 		g_driver->flipBuffer();
 
@@ -620,6 +661,18 @@ void GrimEngine::doFlip() {
 	}
 }
 
+void GrimEngine::drawProfilerOverlay() {
+#ifdef ENABLE_ZONE_PROFILER
+	Common::Array<Common::Profiler::ZoneStats> stats;
+	Common::Profiler::instance().getStats(stats);
+
+	for (uint i = 0; i < stats.size(); i++) {
+		Common::String line = Common::Profiler::formatStats(stats[i]);
+		g_driver->drawEmergString(5, 45 + i * 13, line.c_str(), Color(255, 255, 255));
+	}
+#endif
+}
+
 void GrimEngine::mainLoop() {
 	_movieTime = 0;
 	_frameTime = 0;
@@ -635,6 +688,8 @@ void GrimEngine::mainLoop() {
 	_setupChanged = true;
 
 	for (;;) {
+		PROFILE_ZONE("GrimEngine::mainLoop");
+
 		uint32 startTime = g_system->getMillis();
 		if (_shortFrame) {
 			if (resetShortFrame) {
@@ -652,6 +707,11 @@ void GrimEngine::mainLoop() {
 		if (_savegameSaveRequest) {
 			savegameSave();
 		}
+		if (_saveWriter->getFailedWrites()) {
+			warning("GrimEngine::mainLoop() Can't write savegame file. (Disk full?)");
+			//TODO: Translate this!
+			GUI::displayErrorDialog("Error: the game could not be saved.");
+		}
 
 		if (_changeHardwareState || _changeFullscreenState) {
 			_changeHardwareState = false;
@@ -668,14 +728,15 @@ void GrimEngine::mainLoop() {
 
 			EngineMode mode = getMode();
 
-			_savegameFileName = "";
-			savegameSave();
+			// Keep the state in memory while the renderer is recreated
+			Common::SeekableReadStream *snapshot = savegameSnapshot(false);
 			clearPools();
 
 			delete g_driver;
 			createRenderer();
 			g_driver->setupScreen(screenWidth, screenHeight, fullscreen);
-			savegameRestore();
+			_savedState = SaveGame::openForLoading(snapshot);
+			restoreSavedState();
 
 			if (mode == DrawMode) {
 				setMode(GrimEngine::NormalMode);
@@ -780,9 +841,18 @@ void GrimEngine::savegameRestore() {
 	} else {
 		filename = _savegameFileName;
 	}
+	// The savegame may still be being written
+	waitForSavegameWrites();
+
 	_savedState = SaveGame::openForLoading(filename);
 	if (!_savedState || !_savedState->isCompatible())
 		return;
+
+	restoreSavedState();
+	debug("GrimEngine::savegameRestore() finished.");
+}
+
+void GrimEngine::restoreSavedState() {
 	g_imuse->stopAllSounds();
 	g_imuse->resetState();
 	g_movie->stop();
@@ -849,7 +919,6 @@ void GrimEngine::savegameRestore() {
 	LuaBase::instance()->postRestoreHandle();
 	g_imuse->pause(false);
 	g_movie->pause(false);
-	debug("GrimEngine::savegameRestore() finished.");
 
 	_shortFrame = true;
 	clearEventQueue();
@@ -917,9 +986,13 @@ void GrimEngine::storeSaveGameImage(SaveGame *state) {
 		int size = screenshot->getWidth() * screenshot->getHeight();
 		screenshot->setActiveImage(0);
 		uint16 *data = (uint16 *)screenshot->getData().getRawBuffer();
+#ifdef SCUMM_LITTLE_ENDIAN
+		state->write(data, size * 2);
+#else
 		for (int l = 0; l < size; l++) {
 			state->writeLEUint16(data[l]);
 		}
+#endif
 	} else {
 		error("Unable to store screenshot");
 	}
@@ -940,14 +1013,29 @@ void GrimEngine::savegameSave() {
 	if (getGameType() == GType_MONKEY4 && filename.contains('/')) {
 		filename = Common::lastPathComponent(filename, '/');
 	}
-	_savedState = SaveGame::openForSaving(filename);
-	if (!_savedState) {
+	Common::OutSaveFile *file = g_system->getSavefileManager()->openForSaving(filename);
+	if (!file) {
+		warning("GrimEngine::savegameSave() Error creating savegame file %s", filename.c_str());
 		//TODO: Translate this!
 		GUI::displayErrorDialog("Error: the game could not be saved.");
 		return;
 	}
 
-	storeSaveGameImage(_savedState);
+	// Serialize the state now, the compression and the disk
+	// access happen on the writer thread
+	_saveWriter->write(file, savegameSnapshot(true));
+
+	debug("GrimEngine::savegameSave() finished.");
+
+	_shortFrame = true;
+	clearEventQueue();
+}
+
+Common::SeekableReadStream *GrimEngine::savegameSnapshot(bool storeImage) {
+	_savedState = SaveGame::openForSnapshot();
+
+	if (storeImage)
+		storeSaveGameImage(_savedState);
 
 	g_imuse->pause(true);
 	g_movie->pause(true);
@@ -997,14 +1085,18 @@ void GrimEngine::savegameSave() {
 
 	lua_Save(_savedState);
 
+	Common::SeekableReadStream *snapshot = _savedState->finishSnapshot();
 	delete _savedState;
+	_savedState = NULL;
 
 	g_imuse->pause(false);
 	g_movie->pause(false);
-	debug("GrimEngine::savegameSave() finished.");
 
-	_shortFrame = true;
-	clearEventQueue();
+	return snapshot;
+}
+
+void GrimEngine::waitForSavegameWrites() {
+	_saveWriter->waitForWrites();
 }
 
 void GrimEngine::saveGRIM() {
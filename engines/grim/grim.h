@@ -34,10 +34,16 @@
 #include "engines/grim/textobject.h"
 #include "engines/grim/iris.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Grim {
 
 class Actor;
+class ActorIndex;
 class SaveGame;
+class SaveGameWriter;
 class Bitmap;
 class Font;
 class Color;
@@ -107,6 +113,11 @@ public:
 	void setSpeechMode(SpeechMode mode) { _speechMode = mode; }
 	SpeechMode getSpeechMode() { return _speechMode; }
 	SaveGame *savedState() { return _savedState; }
+	/**
+	 * Wait for the savegames being written in the background,
+	 * to be called before accessing the savefiles.
+	 */
+	void waitForSavegameWrites();
 
 	void handleDebugLoadResource();
 	void luaUpdate();
@@ -114,6 +125,8 @@ public:
 	void doFlip();
 	void setFlipEnable(bool state) { _flipEnable = state; }
 	bool getFlipEnable() { return _flipEnable; }
+	/** Show the statistics of the profiling zones over the game. */
+	void setShowProfiler(bool show) { _showProfiler = show; }
 	void refreshDrawMode() { _refreshDrawNeeded = true; }
 	void drawPrimitives();
 	void playIrisAnimation(Iris::Direction dir, int x, int y, int time);
@@ -159,6 +172,15 @@ public:
 	 * Return a list of the currently active actors, i. e. the actors in the current set.
 	 */
 	const Common::List<Actor *> &getActiveActors() const { return _activeActors; }
+	/**
+	 * Return the actors which can collide, sorted by set and position.
+	 */
+	ActorIndex *getActorIndex() { return _actorIndex; }
+	/**
+	 * Wait until the poses of the actors updated so far are evaluated. This must
+	 * be called before running Lua code while the actors are being updated.
+	 */
+	void finishActorsAnimation();
 
 	/**
 	 * Add an actor to the list of actors that are talking
@@ -204,9 +226,11 @@ protected:
 	virtual void drawNormalMode();
 
 	void savegameSave();
+	Common::SeekableReadStream *savegameSnapshot(bool storeImage);
 	void saveGRIM();
 
 	void savegameRestore();
+	void restoreSavedState();
 	void restoreGRIM();
 
 	void storeSaveGameImage(SaveGame *savedState);
@@ -215,6 +239,7 @@ protected:
 	bool _savegameSaveRequest;
 	Common::String _savegameFileName;
 	SaveGame *_savedState;
+	SaveGameWriter *_saveWriter;
 
 	Set *_currSet;
 	EngineMode _mode, _previousMode;
@@ -236,11 +261,15 @@ protected:
 	unsigned int _lastFrameTime;
 	unsigned _speedLimitMs;
 	bool _showFps;
+	bool _showProfiler;
 	bool _softRenderer;
 
 	bool *_controlsEnabled;
 	bool *_controlsState;
 
+	static void animateActor(void *actor);
+	void drawProfilerOverlay();
+
 	bool _changeHardwareState;
 	bool _changeFullscreenState;
 
@@ -250,6 +279,8 @@ protected:
 
 	bool _buildActiveActorsList;
 	Common::List<Actor *> _activeActors;
+	ActorIndex *_actorIndex;
+	Common::ThreadPool *_animationPool;
 	Common::List<Actor *> _talkingActors;
 
 	uint32 _gameFlags;
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/timer.h"
 
@@ -201,6 +202,7 @@ int32 Imuse::makeMixerFlags(int32 flags) {
 }
 
 void Imuse::callback() {
+	PROFILE_ZONE("Imuse::callback");
 	Common::StackLock lock(_mutex);
 
 	for (int l = 0; l < MAX_IMUSE_TRACKS + MAX_IMUSE_FADETRACKS; l++) {
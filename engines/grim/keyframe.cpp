@@ -160,7 +160,14 @@ KeyframeAnim::~KeyframeAnim() {
 	g_resourceloader->uncacheKeyframe(this);
 }
 
-bool KeyframeAnim::animate(ModelNode *nodes, int num, float time, float fade, bool tagged) const {
+void AnimPose::resize(int numNodes) {
+	_pos.resize(numNodes);
+	_pitch.resize(numNodes);
+	_yaw.resize(numNodes);
+	_roll.resize(numNodes);
+}
+
+bool KeyframeAnim::animate(AnimPose &pose, const ModelNode *nodes, int num, float time, float fade, bool tagged, int *cursors) const {
 	// Without this sending the bread down the tube in "mo" often crashes,
 	// because it goes outside the bounds of the array of the nodes.
 	if (num >= _numJoints)
@@ -172,7 +179,7 @@ bool KeyframeAnim::animate(ModelNode *nodes, int num, float time, float fade, bo
 		frame = _numFrames;
 
 	if (_nodes[num] && tagged == ((_type & nodes[num]._type) != 0)) {
-		return _nodes[num]->animate(nodes[num], frame, fade, (_flags & 256) == 0);
+		return _nodes[num]->animate(pose, num, nodes[num], frame, fade, (_flags & 256) == 0, cursors[num]);
 	} else {
 		return false;
 	}
@@ -218,6 +225,7 @@ void KeyframeAnim::KeyframeNode::loadBinary(Common::SeekableReadStream *data, ch
 		data->read(kfEntry, 56);
 		_entries[i].loadBinary(kfEntry);
 	}
+	checkSorted();
 }
 
 void KeyframeAnim::KeyframeNode::loadText(TextSplitter &ts) {
@@ -241,27 +249,51 @@ void KeyframeAnim::KeyframeNode::loadText(TextSplitter &ts) {
 		_entries[which]._dyaw = dyaw;
 		_entries[which]._droll = dr;
 	}
+	checkSorted();
+}
+
+void KeyframeAnim::KeyframeNode::checkSorted() {
+	_sorted = true;
+	for (int i = 1; i < _numEntries; i++) {
+		if (_entries[i]._frame < _entries[i - 1]._frame)
+			_sorted = false;
+	}
+}
+
+int KeyframeAnim::KeyframeNode::findEntry(float frame, int &cursor) const {
+	// The animations mostly go forward, so the entry is usually the one of the
+	// previous frame or one of the next ones. Search the other cases.
+	int low = cursor;
+	if (!_sorted || low < 0 || low >= _numEntries || _entries[low]._frame > frame) {
+		// Do a binary search for the nearest previous frame
+		// Loop invariant: entries_[low].frame_ <= frame < entries_[high].frame_
+		low = 0;
+		int high = _numEntries;
+		while (high > low + 1) {
+			int mid = (low + high) / 2;
+			if (_entries[mid]._frame <= frame)
+				low = mid;
+			else
+				high = mid;
+		}
+	} else {
+		while (low + 1 < _numEntries && _entries[low + 1]._frame <= frame)
+			low++;
+	}
+
+	cursor = low;
+	return low;
 }
 
 KeyframeAnim::KeyframeNode::~KeyframeNode() {
 	delete[] _entries;
 }
 
-bool KeyframeAnim::KeyframeNode::animate(ModelNode &node, float frame, float fade, bool useDelta) const {
+bool KeyframeAnim::KeyframeNode::animate(AnimPose &pose, int num, const ModelNode &node, float frame, float fade, bool useDelta, int &cursor) const {
 	if (_numEntries == 0)
 		return false;
 
-	// Do a binary search for the nearest previous frame
-	// Loop invariant: entries_[low].frame_ <= frame < entries_[high].frame_
-	int low = 0, high = _numEntries;
-	while (high > low + 1) {
-		int mid = (low + high) / 2;
-		if (_entries[mid]._frame <= frame)
-			low = mid;
-		else
-			high = mid;
-	}
-
+	int low = findEntry(frame, cursor);
 	float dt = frame - _entries[low]._frame;
 	Math::Vector3d pos = _entries[low]._pos;
 	Math::Angle pitch = _entries[low]._pitch;
@@ -281,16 +313,16 @@ bool KeyframeAnim::KeyframeNode::animate(ModelNode &node, float frame, float fad
 		roll += dt * _entries[low]._droll;
 	}
 
-	node._animPos += (pos - node._pos) * fade;
+	pose._pos[num] += (pos - node._pos) * fade;
 
 	Math::Angle dpitch = pitch - node._pitch;
-	node._animPitch += dpitch.normalize(-180) * fade;
+	pose._pitch[num] += dpitch.normalize(-180) * fade;
 
 	Math::Angle dyaw = yaw - node._yaw;
-	node._animYaw += dyaw.normalize(-180) * fade;
+	pose._yaw[num] += dyaw.normalize(-180) * fade;
 
 	Math::Angle droll = roll - node._roll;
-	node._animRoll += droll.normalize(-180) * fade;
+	pose._roll[num] += droll.normalize(-180) * fade;
 
 	return true;
 }
@@ -23,6 +23,9 @@
 #ifndef GRIM_KEYFRAME_H
 #define GRIM_KEYFRAME_H
 
+#include "common/array.h"
+
+#include "math/angle.h"
 #include "math/vector3d.h"
 
 #include "engines/grim/object.h"
@@ -36,6 +39,17 @@ namespace Grim {
 class ModelNode;
 class TextSplitter;
 
+/**
+ * The offsets from the bind pose of the nodes of a hierarchy, as in
+ * ModelNode::_animPos and co., with one array per channel.
+ */
+struct AnimPose {
+	void resize(int numNodes);
+
+	Common::Array<Math::Vector3d> _pos;
+	Common::Array<Math::Angle> _pitch, _yaw, _roll;
+};
+
 class KeyframeAnim : public Object {
 public:
 	KeyframeAnim(const Common::String &filename, Common::SeekableReadStream *data);
@@ -43,10 +57,15 @@ public:
 
 	void loadBinary(Common::SeekableReadStream *data);
 	void loadText(TextSplitter &ts);
-	bool animate(ModelNode *nodes, int num, float time, float fade, bool tagged) const;
+	/**
+	 * Blend the pose of the node num at the given time into pose. cursors holds
+	 * the keyframe of each joint found by the previous call, one per joint.
+	 */
+	bool animate(AnimPose &pose, const ModelNode *nodes, int num, float time, float fade, bool tagged, int *cursors) const;
 	int getMarker(float startTime, float stopTime) const;
 
 	float getLength() const { return _numFrames / _fps; }
+	int getNumJoints() const { return _numJoints; }
 	const Common::String &getFilename() const { return _fname; }
 
 private:
@@ -83,11 +102,18 @@ private:
 		void loadText(TextSplitter &ts);
 		~KeyframeNode();
 
-		bool animate(ModelNode &node, float frame, float fade, bool useDelta) const;
+		void checkSorted();
+		/**
+		 * Return the last entry starting at or before frame, stepping from the
+		 * one found for the previous frame.
+		 */
+		int findEntry(float frame, int &cursor) const;
+		bool animate(AnimPose &pose, int num, const ModelNode &node, float frame, float fade, bool useDelta, int &cursor) const;
 
 		char _meshName[32];
 		int _numEntries;
 		KeyframeEntry *_entries;
+		bool _sorted;
 	};
 
 	KeyframeNode **_nodes;
@@ -513,6 +513,7 @@ void Lua_V1::GetSaveGameImage() {
 		return;
 	}
 	const char *filename = lua_getstring(param);
+	g_grim->waitForSavegameWrites();
 	SaveGame *savedState = SaveGame::openForLoading(filename);
 	if (!savedState || !savedState->isCompatible()) {
 		delete savedState;
@@ -570,6 +571,7 @@ void Lua_V1::GetSaveGameData() {
 	if (!lua_isstring(param))
 		return;
 	const char *filename = lua_getstring(param);
+	g_grim->waitForSavegameWrites();
 	SaveGame *savedState = SaveGame::openForLoading(filename);
 	lua_Object result = lua_createtable();
 
@@ -640,6 +642,7 @@ void Lua_V1::Save() {
 }
 
 void Lua_V1::Remove() {
+	g_grim->waitForSavegameWrites();
 	if (g_system->getSavefileManager()->removeSavefile(luaL_check_string(1)))
 		lua_pushuserdata(0);
 	else {
@@ -25,6 +25,7 @@
 #include "common/textconsole.h"
 
 #include "engines/grim/movie/codecs/blocky16.h"
+#include "engines/grim/movie/codecs/blocky_simd.h"
 
 namespace Grim {
 
@@ -360,6 +361,42 @@ void Blocky16::makeTables47(int width) {
 	} while (c < 32768);
 }
 
+void Blocky16::copyBlock(byte *d_dst, int32 offset, int width, int rows) {
+#ifdef BLOCKY_SIMD
+	if (_useSIMD) {
+		if (width == 16)
+			blockyCopyRows16(d_dst, d_dst + offset, _d_pitch, rows);
+		else
+			blockyCopyRows8(d_dst, d_dst + offset, _d_pitch, rows);
+		return;
+	}
+#endif
+	while (rows--) {
+		for (int x = 0; x < width; x += 4) {
+			COPY_4X1_LINE(d_dst + x, d_dst + offset + x);
+		}
+		d_dst += _d_pitch;
+	}
+}
+
+void Blocky16::fillBlock(byte *d_dst, uint32 val, int width, int rows) {
+#ifdef BLOCKY_SIMD
+	if (_useSIMD) {
+		if (width == 16)
+			blockyFillRows16(d_dst, val, _d_pitch, rows);
+		else
+			blockyFillRows8(d_dst, val, _d_pitch, rows);
+		return;
+	}
+#endif
+	while (rows--) {
+		for (int x = 0; x < width; x += 4) {
+			WRITE_4X1_LINE(d_dst + x, val);
+		}
+		d_dst += _d_pitch;
+	}
+}
+
 void Blocky16::level3(byte *d_dst) {
 	int32 tmp2;
 	uint32 t;
@@ -431,7 +468,6 @@ void Blocky16::level2(byte *d_dst) {
 	int32 tmp2;
 	uint32 t = 0, val;
 	byte code = *_d_src++;
-	int i;
 
 	if (code <= 0xF5) {
 		if (code == 0xF5) {
@@ -442,11 +478,7 @@ void Blocky16::level2(byte *d_dst) {
 			tmp2 = _table[code] * 2;
 		}
 		tmp2 += _offset1;
-		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2, 8, 4);
 	} else if (code == 0xFF) {
 		level3(d_dst);
 		d_dst += 4;
@@ -457,11 +489,7 @@ void Blocky16::level2(byte *d_dst) {
 		level3(d_dst);
 	} else if (code == 0xF6) {
 		tmp2 = _offset2;
-		for (i = 0; i < 4; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2, 8, 4);
 	} else if ((code == 0xF7) || (code == 0xF8)) {
 		byte tmp = *_d_src++;
 		if (code == 0xF8) {
@@ -500,11 +528,7 @@ void Blocky16::level2(byte *d_dst) {
 			t = READ_LE_UINT16(_paramPtr + code * 2);
 			t = (t << 16) | t;
 		}
-		for (i = 0; i < 4; i++) {
-			WRITE_4X1_LINE(d_dst + 0, t);
-			WRITE_4X1_LINE(d_dst + 4, t);
-			d_dst += _d_pitch;
-		}
+		fillBlock(d_dst, t, 8, 4);
 	}
 }
 
@@ -512,7 +536,6 @@ void Blocky16::level1(byte *d_dst) {
 	int32 tmp2;
 	uint32 t = 0, val;
 	byte code = *_d_src++;
-	int i;
 
 	if (code <= 0xF5) {
 		if (code == 0xF5) {
@@ -523,13 +546,7 @@ void Blocky16::level1(byte *d_dst) {
 			tmp2 = _table[code] * 2;
 		}
 		tmp2 += _offset1;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			COPY_4X1_LINE(d_dst +  8, d_dst + tmp2 +  8);
-			COPY_4X1_LINE(d_dst + 12, d_dst + tmp2 + 12);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2, 16, 8);
 	} else if (code == 0xFF) {
 		level2(d_dst);
 		d_dst += 8;
@@ -540,13 +557,7 @@ void Blocky16::level1(byte *d_dst) {
 		level2(d_dst);
 	} else if (code == 0xF6) {
 		tmp2 = _offset2;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst +  0, d_dst + tmp2 +  0);
-			COPY_4X1_LINE(d_dst +  4, d_dst + tmp2 +  4);
-			COPY_4X1_LINE(d_dst +  8, d_dst + tmp2 +  8);
-			COPY_4X1_LINE(d_dst + 12, d_dst + tmp2 + 12);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2, 16, 8);
 	} else if ((code == 0xF7) || (code == 0xF8)) {
 		byte tmp = *_d_src++;
 		if (code == 0xF8) {
@@ -585,13 +596,7 @@ void Blocky16::level1(byte *d_dst) {
 			t = READ_LE_UINT16(_paramPtr + code * 2);
 			t = (t << 16) | t;
 		}
-		for (i = 0; i < 8; i++) {
-			WRITE_4X1_LINE(d_dst +  0, t);
-			WRITE_4X1_LINE(d_dst +  4, t);
-			WRITE_4X1_LINE(d_dst +  8, t);
-			WRITE_4X1_LINE(d_dst + 12, t);
-			d_dst += _d_pitch;
-		}
+		fillBlock(d_dst, t, 16, 8);
 	}
 }
 
@@ -617,6 +622,7 @@ void Blocky16::init(int width, int height) {
 	deinit();
 	_width = width;
 	_height = height;
+	_useSIMD = Common::hasSIMD();
 	makeTablesInterpolation(4);
 	makeTablesInterpolation(8);
 
@@ -644,6 +650,7 @@ Blocky16::Blocky16() {
 	memset(_tableBig, 0, 99328);
 	memset(_tableSmall, 0, 32768);
 	_deltaBuf = NULL;
+	_useSIMD = false;
 }
 
 void Blocky16::deinit() {
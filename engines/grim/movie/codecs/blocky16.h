@@ -45,9 +45,12 @@ private:
 	int _offset;
 	int _width, _height;
 	int _blocksWidth, _blocksHeight;
+	bool _useSIMD;
 
 	void makeTablesInterpolation(int param);
 	void makeTables47(int width);
+	void copyBlock(byte *d_dst, int32 offset, int width, int rows);
+	void fillBlock(byte *d_dst, uint32 val, int width, int rows);
 	void level1(byte *d_dst);
 	void level2(byte *d_dst);
 	void level3(byte *d_dst);
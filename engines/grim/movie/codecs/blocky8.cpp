@@ -26,6 +26,7 @@
 #include "common/textconsole.h"
 
 #include "engines/grim/movie/codecs/blocky8.h"
+#include "engines/grim/movie/codecs/blocky_simd.h"
 
 namespace Grim {
 
@@ -361,6 +362,34 @@ extern "C" void ARM_Blocky8_decode2(      byte  *dst,
                    _offset1,_offset2,_tableSmall)
 
 #else
+void Blocky8::copyBlock(byte *d_dst, int32 offset) {
+#ifdef BLOCKY_SIMD
+	if (_useSIMD) {
+		blockyCopyRows8(d_dst, d_dst + offset, _d_pitch, 8);
+		return;
+	}
+#endif
+	for (int i = 0; i < 8; i++) {
+		COPY_4X1_LINE(d_dst + 0, d_dst + offset);
+		COPY_4X1_LINE(d_dst + 4, d_dst + offset + 4);
+		d_dst += _d_pitch;
+	}
+}
+
+void Blocky8::fillBlock(byte *d_dst, byte val) {
+#ifdef BLOCKY_SIMD
+	if (_useSIMD) {
+		blockyFillRows8(d_dst, val * 0x01010101, _d_pitch, 8);
+		return;
+	}
+#endif
+	for (int i = 0; i < 8; i++) {
+		FILL_4X1_LINE(d_dst, val);
+		FILL_4X1_LINE(d_dst + 4, val);
+		d_dst += _d_pitch;
+	}
+}
+
 void Blocky8::level3(byte *d_dst) {
 	int32 tmp;
 	byte code = *_d_src++;
@@ -447,15 +476,10 @@ void Blocky8::level2(byte *d_dst) {
 void Blocky8::level1(byte *d_dst) {
 	int32 tmp, tmp2;
 	byte code = *_d_src++;
-	int i;
 
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2);
 	} else if (code == 0xFF) {
 		level2(d_dst);
 		d_dst += 4;
@@ -466,11 +490,7 @@ void Blocky8::level1(byte *d_dst) {
 		level2(d_dst);
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _d_pitch;
-		}
+		fillBlock(d_dst, t);
 	} else if (code == 0xFD) {
 		tmp = *_d_src++;
 		byte *tmp_ptr = _tableBig + tmp * 388;
@@ -490,18 +510,10 @@ void Blocky8::level1(byte *d_dst) {
 		}
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
-		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
-			d_dst += _d_pitch;
-		}
+		copyBlock(d_dst, tmp2);
 	} else {
 		byte t = _paramPtr[code];
-		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
-			d_dst += _d_pitch;
-		}
+		fillBlock(d_dst, t);
 	}
 }
 
@@ -553,11 +565,13 @@ Blocky8::Blocky8() {
 	memset(_tableBig, 0, 99328);
 	memset(_tableSmall, 0, 32768);
 	_deltaBuf = NULL;
+	_useSIMD = false;
 	_width = -1;
 	_height = -1;
 }
 
 void Blocky8::init(int width, int height) {
+	_useSIMD = Common::hasSIMD();
 	if (_width == width && _height == height)
 		return;
 	deinit();
@@ -43,9 +43,12 @@ private:
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
+	bool _useSIMD;
 
 	void makeTablesInterpolation(int param);
 	void makeTables47(int width);
+	void copyBlock(byte *d_dst, int32 offset);
+	void fillBlock(byte *d_dst, byte val);
 	void level1(byte *d_dst);
 	void level2(byte *d_dst);
 	void level3(byte *d_dst);
@@ -0,0 +1,106 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRIM_BLOCKY_SIMD_H
+#define GRIM_BLOCKY_SIMD_H
+
+#include "common/simd.h"
+
+/**
+ * Vectorized row copies and fills shared by the Blocky8 and Blocky16
+ * SMUSH codecs. They move whole 8 or 16 byte block rows with a single
+ * unaligned load/store instead of four byte chunks, so they produce the
+ * same output as the scalar macros as long as the source and destination
+ * rows do not overlap, which is always the case for the motion
+ * compensated copies since they read from another frame buffer.
+ *
+ * BLOCKY_SIMD is only defined when a vector instruction set is compiled
+ * in; the callers must still check Common::hasSIMD() before using them.
+ */
+
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+
+#define BLOCKY_SIMD
+
+namespace Grim {
+
+static FORCEINLINE void blockyCopyRows16(byte *dst, const byte *src, int pitch, int rows) {
+	while (rows--) {
+#if defined(SCUMMVM_SSE2)
+		_mm_storeu_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+#else
+		vst1q_u8(dst, vld1q_u8(src));
+#endif
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static FORCEINLINE void blockyFillRows16(byte *dst, uint32 val, int pitch, int rows) {
+#if defined(SCUMMVM_SSE2)
+	const __m128i v = _mm_set1_epi32((int)val);
+#else
+	const uint8x16_t v = vreinterpretq_u8_u32(vdupq_n_u32(val));
+#endif
+	while (rows--) {
+#if defined(SCUMMVM_SSE2)
+		_mm_storeu_si128((__m128i *)dst, v);
+#else
+		vst1q_u8(dst, v);
+#endif
+		dst += pitch;
+	}
+}
+
+static FORCEINLINE void blockyCopyRows8(byte *dst, const byte *src, int pitch, int rows) {
+	while (rows--) {
+#if defined(SCUMMVM_SSE2)
+		_mm_storel_epi64((__m128i *)dst, _mm_loadl_epi64((const __m128i *)src));
+#else
+		vst1_u8(dst, vld1_u8(src));
+#endif
+		dst += pitch;
+		src += pitch;
+	}
+}
+
+static FORCEINLINE void blockyFillRows8(byte *dst, uint32 val, int pitch, int rows) {
+#if defined(SCUMMVM_SSE2)
+	const __m128i v = _mm_set1_epi32((int)val);
+#else
+	const uint8x8_t v = vreinterpret_u8_u32(vdup_n_u32(val));
+#endif
+	while (rows--) {
+#if defined(SCUMMVM_SSE2)
+		_mm_storel_epi64((__m128i *)dst, v);
+#else
+		vst1_u8(dst, v);
+#endif
+		dst += pitch;
+	}
+}
+
+} // End of namespace Grim
+
+#endif
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "graphics/surface.h"
 
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/timer.h"
 
@@ -75,6 +76,7 @@ void MoviePlayer::stop() {
 }
 
 void MoviePlayer::timerCallback(void *instance) {
+	PROFILE_ZONE("MoviePlayer::timerCallback");
 	MoviePlayer *movie = static_cast<MoviePlayer *>(instance);
 	Common::StackLock lock(movie->_frameMutex);
 	if (movie->prepareFrame())
@@ -21,8 +21,10 @@
  */
 
 #include "common/endian.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 
 #include "math/vector3d.h"
 
@@ -33,9 +35,10 @@ namespace Grim {
 
 #define SAVEGAME_HEADERTAG  'RSAV'
 #define SAVEGAME_FOOTERTAG  'ESAV'
+#define SAVEGAME_TOCTAG     'TOC '
 
 uint SaveGame::SAVEGAME_MAJOR_VERSION = 22;
-uint SaveGame::SAVEGAME_MINOR_VERSION = 8;
+uint SaveGame::SAVEGAME_MINOR_VERSION = 9;
 
 SaveGame *SaveGame::openForLoading(const Common::String &filename) {
 	Common::InSaveFile *inSaveFile = g_system->getSavefileManager()->openForLoading(filename);
@@ -44,6 +47,10 @@ SaveGame *SaveGame::openForLoading(const Common::String &filename) {
 		return NULL;
 	}
 
+	return openForLoading(inSaveFile);
+}
+
+SaveGame *SaveGame::openForLoading(Common::SeekableReadStream *inSaveFile) {
 	SaveGame *save = new SaveGame();
 
 	save->_saving = false;
@@ -57,6 +64,23 @@ SaveGame *SaveGame::openForLoading(const Common::String &filename) {
 	save->_majorVersion = inSaveFile->readUint32BE();
 	save->_minorVersion = inSaveFile->readUint32BE();
 
+	// Savegames since 22.9 start with a table of contents
+	if (save->isCompatible() && save->_minorVersion >= 9) {
+		if (inSaveFile->readUint32BE() != SAVEGAME_TOCTAG) {
+			delete save;
+			return NULL;
+		}
+		inSaveFile->readUint32BE(); // Section size
+
+		uint32 count = inSaveFile->readUint32BE();
+		save->_toc.resize(count);
+		for (uint32 i = 0; i < count; i++) {
+			save->_toc[i].tag = inSaveFile->readUint32BE();
+			save->_toc[i].offset = inSaveFile->readUint32BE();
+			save->_toc[i].size = inSaveFile->readUint32BE();
+		}
+	}
+
 	return save;
 }
 
@@ -67,15 +91,16 @@ SaveGame *SaveGame::openForSaving(const Common::String &filename) {
 		return NULL;
 	}
 
-	SaveGame *save = new SaveGame();
-
-	save->_saving = true;
+	SaveGame *save = openForSnapshot();
 	save->_outSaveFile = outSaveFile;
 
-	outSaveFile->writeUint32BE(SAVEGAME_HEADERTAG);
-	outSaveFile->writeUint32BE(SAVEGAME_MAJOR_VERSION);
-	outSaveFile->writeUint32BE(SAVEGAME_MINOR_VERSION);
+	return save;
+}
+
+SaveGame *SaveGame::openForSnapshot() {
+	SaveGame *save = new SaveGame();
 
+	save->_saving = true;
 	save->_majorVersion = SAVEGAME_MAJOR_VERSION;
 	save->_minorVersion = SAVEGAME_MINOR_VERSION;
 
@@ -85,13 +110,14 @@ SaveGame *SaveGame::openForSaving(const Common::String &filename) {
 SaveGame::SaveGame() :
 		_currentSection(0), _sectionBuffer(nullptr), _majorVersion(0),
 		_minorVersion(0), _saving(false), _inSaveFile(nullptr), _outSaveFile(nullptr),
-		_sectionSize(0), _sectionAlloc(0), _sectionPtr(0) {
+		_sectionSize(0), _sectionAlloc(0), _sectionPtr(0),
+		_data(nullptr), _dataSize(0), _dataAlloc(0) {
 
 }
 
 SaveGame::~SaveGame() {
-	if (_saving) {
-		_outSaveFile->writeUint32BE(SAVEGAME_FOOTERTAG);
+	if (_saving && _outSaveFile) {
+		writeSaveGame(*_outSaveFile);
 		_outSaveFile->finalize();
 		if (_outSaveFile->err())
 			warning("SaveGame::~SaveGame() Can't write file. (Disk full?)");
@@ -99,9 +125,54 @@ SaveGame::~SaveGame() {
 	} else {
 		delete _inSaveFile;
 	}
+	free(_data);
 	free(_sectionBuffer);
 }
 
+Common::SeekableReadStream *SaveGame::finishSnapshot() {
+	assert(_saving && !_outSaveFile && _currentSection == 0);
+
+	uint32 size = getSaveGameSize();
+	byte *data = (byte *)malloc(size);
+
+	Common::MemoryWriteStream stream(data, size);
+	writeSaveGame(stream);
+	_saving = false;
+
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+uint32 SaveGame::getTocSize() const {
+	return 4 + _toc.size() * 12;
+}
+
+uint32 SaveGame::getSaveGameSize() const {
+	// Header, table of contents section, sections and footer
+	return 12 + 8 + getTocSize() + _dataSize + 4;
+}
+
+void SaveGame::writeSaveGame(Common::WriteStream &out) const {
+	out.writeUint32BE(SAVEGAME_HEADERTAG);
+	out.writeUint32BE(SAVEGAME_MAJOR_VERSION);
+	out.writeUint32BE(SAVEGAME_MINOR_VERSION);
+
+	// The section offsets are relative to the serialized sections,
+	// make them relative to the start of the file
+	uint32 dataStart = 12 + 8 + getTocSize();
+
+	out.writeUint32BE(SAVEGAME_TOCTAG);
+	out.writeUint32BE(getTocSize());
+	out.writeUint32BE(_toc.size());
+	for (uint i = 0; i < _toc.size(); i++) {
+		out.writeUint32BE(_toc[i].tag);
+		out.writeUint32BE(dataStart + _toc[i].offset);
+		out.writeUint32BE(_toc[i].size);
+	}
+
+	out.write(_data, _dataSize);
+	out.writeUint32BE(SAVEGAME_FOOTERTAG);
+}
+
 bool SaveGame::isCompatible() const {
 	return _majorVersion == SAVEGAME_MAJOR_VERSION && _minorVersion <= SAVEGAME_MINOR_VERSION;
 }
@@ -122,21 +193,41 @@ uint32 SaveGame::beginSection(uint32 sectionTag) {
 	_currentSection = sectionTag;
 	_sectionSize = 0;
 	if (!_saving) {
-		uint32 tag = 0;
-
-		while (tag != sectionTag) {
-			tag = _inSaveFile->readUint32BE();
-			if (tag == SAVEGAME_FOOTERTAG)
+		if (!_toc.empty()) {
+			// Go straight to the section. Sections are usually read in the
+			// order they were written, in which case this only skips forward.
+			const TocEntry *entry = nullptr;
+			for (uint i = 0; i < _toc.size(); i++) {
+				if (_toc[i].tag == sectionTag) {
+					entry = &_toc[i];
+					break;
+				}
+			}
+			if (!entry)
 				error("Unable to find requested section of savegame");
-			_sectionSize = _inSaveFile->readUint32BE();
-			_inSaveFile->seek(_sectionSize, SEEK_CUR);
+
+			_sectionSize = entry->size;
+			if (_inSaveFile->pos() != (int32)entry->offset)
+				_inSaveFile->seek(entry->offset);
+		} else {
+			// Older savegames, look for the section after the current one
+			for (;;) {
+				uint32 tag = _inSaveFile->readUint32BE();
+				if (tag == SAVEGAME_FOOTERTAG || _inSaveFile->eos())
+					error("Unable to find requested section of savegame");
+				_sectionSize = _inSaveFile->readUint32BE();
+				if (tag == sectionTag)
+					break;
+				_inSaveFile->skip(_sectionSize);
+			}
 		}
 		if (!_sectionBuffer || _sectionAlloc < _sectionSize) {
 			_sectionAlloc = _sectionSize;
 			_sectionBuffer = (byte *)realloc(_sectionBuffer, _sectionAlloc);
 		}
 
-		_inSaveFile->seek(-(int32)_sectionSize, SEEK_CUR);
+		// Read the data directly, seeking backwards in compressed
+		// savefiles would inflate them again from the start
 		_inSaveFile->read(_sectionBuffer, _sectionSize);
 
 	} else {
@@ -153,9 +244,19 @@ void SaveGame::endSection() {
 	if (_currentSection == 0)
 		error("Tried to end a save game section without starting a section");
 	if (_saving) {
-		_outSaveFile->writeUint32BE(_currentSection);
-		_outSaveFile->writeUint32BE(_sectionSize);
-		_outSaveFile->write(_sectionBuffer, _sectionSize);
+		TocEntry entry;
+		entry.tag = _currentSection;
+		entry.offset = _dataSize + 8;
+		entry.size = _sectionSize;
+		_toc.push_back(entry);
+
+		// Sections keep their header, for the readers which
+		// look for them without using the table of contents
+		byte header[8];
+		WRITE_BE_UINT32(header, _currentSection);
+		WRITE_BE_UINT32(header + 4, _sectionSize);
+		appendData(header, 8);
+		appendData(_sectionBuffer, _sectionSize);
 	}
 	_currentSection = 0;
 }
@@ -213,6 +314,17 @@ bool SaveGame::readBool() {
 	return readByte() != 0;
 }
 
+void SaveGame::appendData(const void *data, uint32 size) {
+	if (_dataSize + size > _dataAlloc) {
+		_dataAlloc = MAX<uint32>(_dataAlloc * 2, _dataSize + size);
+		_data = (byte *)realloc(_data, _dataAlloc);
+		if (!_data)
+			error("Failed to allocate space for savegame");
+	}
+	memcpy(_data + _dataSize, data, size);
+	_dataSize += size;
+}
+
 void SaveGame::checkAlloc(int size) {
 	if (_sectionSize + size > _sectionAlloc) {
 		while (_sectionSize + size > _sectionAlloc)
@@ -342,4 +454,54 @@ Common::String SaveGame::readString() {
 	return s;
 }
 
+SaveGameWriter::SaveGameWriter() :
+		_pool(new Common::ThreadPool(1)), _failedWrites(0) {
+}
+
+SaveGameWriter::~SaveGameWriter() {
+	delete _pool;
+}
+
+void SaveGameWriter::write(Common::OutSaveFile *file, Common::SeekableReadStream *snapshot) {
+	WriteJob *job = new WriteJob();
+	job->writer = this;
+	job->file = file;
+	job->snapshot = snapshot;
+
+	_pool->addJob(&writeJob, job);
+}
+
+void SaveGameWriter::waitForWrites() {
+	_pool->waitForJobs();
+}
+
+uint SaveGameWriter::getFailedWrites() {
+	Common::StackLock lock(_mutex);
+
+	uint failed = _failedWrites;
+	_failedWrites = 0;
+	return failed;
+}
+
+void SaveGameWriter::writeJob(void *data) {
+	WriteJob *job = (WriteJob *)data;
+
+	byte buffer[16384];
+	while (!job->snapshot->eos()) {
+		uint32 size = job->snapshot->read(buffer, sizeof(buffer));
+		job->file->write(buffer, size);
+	}
+
+	job->file->finalize();
+	if (job->file->err()) {
+		// Reported by the engine on the main thread
+		Common::StackLock lock(job->writer->_mutex);
+		job->writer->_failedWrites++;
+	}
+
+	delete job->file;
+	delete job->snapshot;
+	delete job;
+}
+
 } // end of namespace Grim
@@ -23,6 +23,9 @@
 #ifndef GRIM_SAVEGAME_H
 #define GRIM_SAVEGAME_H
 
+#include "common/array.h"
+#include "common/mutex.h"
+
 #include "math/mathfwd.h"
 
 namespace Common {
@@ -31,6 +34,7 @@ typedef SeekableReadStream InSaveFile;
 class WriteStream;
 typedef WriteStream OutSaveFile;
 class String;
+class ThreadPool;
 }
 
 namespace Grim {
@@ -40,9 +44,25 @@ class Color;
 class SaveGame {
 public:
 	static SaveGame *openForLoading(const Common::String &filename);
+	/**
+	 * Read a savegame from a stream, such as a snapshot.
+	 * The savegame takes ownership of the stream.
+	 */
+	static SaveGame *openForLoading(Common::SeekableReadStream *stream);
 	static SaveGame *openForSaving(const Common::String &filename);
+	/**
+	 * Create a savegame serialized in memory.
+	 * Its data is retrieved with finishSnapshot().
+	 */
+	static SaveGame *openForSnapshot();
 	~SaveGame();
 
+	/**
+	 * Terminate a snapshot savegame and return its data.
+	 * The caller takes ownership of the returned stream.
+	 */
+	Common::SeekableReadStream *finishSnapshot();
+
 	/**
 	 * Major savegame version.
 	 * If a savegame has a different major version than SAVEGAME_MAJOR_VERSION
@@ -102,6 +122,65 @@ protected:
 	byte *_sectionBuffer;
 
 	static const int _allocAmmount = 1048576;
+
+	/**
+	 * Location of a section's data in the savegame.
+	 * When saving, the offset is relative to the start of _data.
+	 */
+	struct TocEntry {
+		uint32 tag;
+		uint32 offset;
+		uint32 size;
+	};
+
+	Common::Array<TocEntry> _toc;
+
+	// The sections serialized so far, written out when the savegame is closed
+	byte *_data;
+	uint32 _dataSize;
+	uint32 _dataAlloc;
+
+	void appendData(const void *data, uint32 size);
+	uint32 getTocSize() const;
+	uint32 getSaveGameSize() const;
+	void writeSaveGame(Common::WriteStream &out) const;
+};
+
+/**
+ * Writes savegame snapshots to disk on a background thread, so
+ * that the compression and the file system access don't stall
+ * the game.
+ */
+class SaveGameWriter {
+public:
+	SaveGameWriter();
+	/** Waits for the pending writes to complete */
+	~SaveGameWriter();
+
+	/**
+	 * Queue writing a snapshot to an opened savefile.
+	 * The writer takes ownership of both streams.
+	 */
+	void write(Common::OutSaveFile *file, Common::SeekableReadStream *snapshot);
+
+	/** Wait until all the queued snapshots have been written */
+	void waitForWrites();
+
+	/** Return the number of writes which failed since the last call */
+	uint getFailedWrites();
+
+private:
+	struct WriteJob {
+		SaveGameWriter *writer;
+		Common::OutSaveFile *file;
+		Common::SeekableReadStream *snapshot;
+	};
+
+	static void writeJob(void *data);
+
+	Common::ThreadPool *_pool;
+	Common::Mutex _mutex;
+	uint _failedWrites;
 };
 
 } // end of namespace Grim
@@ -544,4 +544,263 @@ bool Sector::operator==(const Sector &other) const {
 	return ok;
 }
 
+SectorIndex::SectorIndex() :
+		_built(false), _useXZ(false), _sectors(NULL), _numSectors(0),
+		_minX(0), _minY(0), _cellWidth(1), _cellHeight(1), _cols(0), _rows(0), _query(0) {
+}
+
+void SectorIndex::getGroundCoords(const Math::Vector3d &p, float &x, float &y) const {
+	x = p.x();
+	y = _useXZ ? p.z() : p.y();
+}
+
+void SectorIndex::getCell(float x, float y, int &col, int &row) const {
+	col = (int)floorf((x - _minX) / _cellWidth);
+	row = (int)floorf((y - _minY) / _cellHeight);
+}
+
+void SectorIndex::build(Sector **sectors, int numSectors, bool useXZ) {
+	_sectors = sectors;
+	_numSectors = MAX(numSectors, 0);
+	_useXZ = useXZ;
+	_cellStart.clear();
+	_entries.clear();
+	_unboundedSectors.clear();
+	_visited.clear();
+	_visited.resize(_numSectors);
+	for (int i = 0; i < _numSectors; i++)
+		_visited[i] = 0;
+	_query = 0;
+	_cols = _rows = 0;
+	_built = true;
+
+	// Find the region of the ground plane each sector can match a point in.
+	// isPointInSector() accepts the points within the height of the plane,
+	// and moving along the normal shifts them horizontally.
+	Common::Array<float> bounds;
+	Common::Array<int> bounded;
+	for (int i = 0; i < _numSectors; i++) {
+		Sector *sector = _sectors[i];
+		if (!sector)
+			continue;
+
+		Math::Vector3d normal = sector->getNormal();
+		float length = normal.getMagnitude();
+		float x, y;
+		getGroundCoords(normal, x, y);
+		float slope = length > 0 ? sqrtf(x * x + y * y) / length : 1.f;
+
+		float reach = 0.f;
+		if (slope > 0) {
+			if (length == 0 || sector->getHeight() >= 9000.f) {
+				_unboundedSectors.push_back(i);
+				continue;
+			}
+			reach = (sector->getHeight() + 0.01f) * slope;
+		}
+		// Keep the polygon well inside its cells, whatever the rounding
+		reach += 0.01f;
+
+		Math::Vector3d *vertices = sector->getVertices();
+		float minX, minY, maxX, maxY;
+		getGroundCoords(vertices[0], minX, minY);
+		maxX = minX;
+		maxY = minY;
+		for (int j = 1; j < sector->getNumVertices(); j++) {
+			getGroundCoords(vertices[j], x, y);
+			minX = MIN(minX, x);
+			minY = MIN(minY, y);
+			maxX = MAX(maxX, x);
+			maxY = MAX(maxY, y);
+		}
+
+		bounded.push_back(i);
+		bounds.push_back(minX - reach);
+		bounds.push_back(minY - reach);
+		bounds.push_back(maxX + reach);
+		bounds.push_back(maxY + reach);
+	}
+
+	if (bounded.empty())
+		return;
+
+	float maxX, maxY;
+	_minX = bounds[0];
+	_minY = bounds[1];
+	maxX = bounds[2];
+	maxY = bounds[3];
+	for (uint i = 1; i < bounded.size(); i++) {
+		_minX = MIN(_minX, bounds[i * 4 + 0]);
+		_minY = MIN(_minY, bounds[i * 4 + 1]);
+		maxX = MAX(maxX, bounds[i * 4 + 2]);
+		maxY = MAX(maxY, bounds[i * 4 + 3]);
+	}
+
+	// Aim for about two cells per sector, with square cells
+	float width = maxX - _minX;
+	float height = maxY - _minY;
+	float cellSize = sqrtf(width * height / (2 * bounded.size()));
+	_cols = CLIP<int>((int)ceilf(width / cellSize), 1, kMaxGridSize);
+	_rows = CLIP<int>((int)ceilf(height / cellSize), 1, kMaxGridSize);
+	_cellWidth = width / _cols;
+	_cellHeight = height / _rows;
+
+	// Count the sectors of each cell, then fill them in index order
+	Common::Array<int> cellRanges;
+	_cellStart.resize(_cols * _rows + 1);
+	for (int i = 0; i <= _cols * _rows; i++)
+		_cellStart[i] = 0;
+	for (uint i = 0; i < bounded.size(); i++) {
+		int col0, row0, col1, row1;
+		getCell(bounds[i * 4 + 0], bounds[i * 4 + 1], col0, row0);
+		getCell(bounds[i * 4 + 2], bounds[i * 4 + 3], col1, row1);
+		col0 = CLIP(col0, 0, _cols - 1);
+		row0 = CLIP(row0, 0, _rows - 1);
+		col1 = CLIP(col1, 0, _cols - 1);
+		row1 = CLIP(row1, 0, _rows - 1);
+		cellRanges.push_back(col0);
+		cellRanges.push_back(row0);
+		cellRanges.push_back(col1);
+		cellRanges.push_back(row1);
+
+		for (int row = row0; row <= row1; row++)
+			for (int col = col0; col <= col1; col++)
+				_cellStart[row * _cols + col + 1]++;
+	}
+	for (int i = 0; i < _cols * _rows; i++)
+		_cellStart[i + 1] += _cellStart[i];
+
+	Common::Array<int> fill;
+	fill.resize(_cols * _rows);
+	for (int i = 0; i < _cols * _rows; i++)
+		fill[i] = _cellStart[i];
+	_entries.resize(_cellStart[_cols * _rows]);
+	for (uint i = 0; i < bounded.size(); i++) {
+		for (int row = cellRanges[i * 4 + 1]; row <= cellRanges[i * 4 + 3]; row++)
+			for (int col = cellRanges[i * 4 + 0]; col <= cellRanges[i * 4 + 2]; col++)
+				_entries[fill[row * _cols + col]++] = bounded[i];
+	}
+}
+
+Sector *SectorIndex::findPointSector(const Math::Vector3d &p, Sector::SectorType type) {
+	const int *cell = NULL, *cellEnd = NULL;
+	if (_cols > 0) {
+		float x, y;
+		getGroundCoords(p, x, y);
+		float col = (x - _minX) / _cellWidth;
+		float row = (y - _minY) / _cellHeight;
+		// Written so that the NaNs are rejected too
+		if (col >= 0 && col < _cols && row >= 0 && row < _rows) {
+			int index = (int)row * _cols + (int)col;
+			cell = _entries.begin() + _cellStart[index];
+			cellEnd = _entries.begin() + _cellStart[index + 1];
+		}
+	}
+
+	// Merge the sectors of the cell with the unbounded ones, so that the
+	// first match is the one with the lowest index, as in a linear search.
+	const int *unbounded = _unboundedSectors.begin();
+	const int *unboundedEnd = _unboundedSectors.end();
+	while (cell != cellEnd || unbounded != unboundedEnd) {
+		int index;
+		if (unbounded == unboundedEnd || (cell != cellEnd && *cell < *unbounded))
+			index = *cell++;
+		else
+			index = *unbounded++;
+
+		Sector *sector = _sectors[index];
+		if ((sector->getType() & type) && sector->isVisible() && sector->isPointInSector(p))
+			return sector;
+	}
+	return NULL;
+}
+
+void SectorIndex::considerClosest(int index, const Math::Vector3d &p, int &result, Math::Vector3d &resultPt, float &minDist) {
+	if (_visited[index] == _query)
+		return;
+	_visited[index] = _query;
+
+	Sector *sector = _sectors[index];
+	if ((sector->getType() & Sector::WalkType) == 0 || !sector->isVisible())
+		return;
+	Math::Vector3d closestPt = sector->getClosestPoint(p);
+	float thisDist = (closestPt - p).getMagnitude();
+	// Ties go to the lowest index, as in a linear search
+	if (result < 0 || thisDist < minDist || (thisDist == minDist && index < result)) {
+		result = index;
+		resultPt = closestPt;
+		minDist = thisDist;
+	}
+}
+
+void SectorIndex::considerCell(int cell, const Math::Vector3d &p, int &result, Math::Vector3d &resultPt, float &minDist) {
+	for (int i = _cellStart[cell]; i < _cellStart[cell + 1]; i++)
+		considerClosest(_entries[i], p, result, resultPt, minDist);
+}
+
+void SectorIndex::findClosestSector(const Math::Vector3d &p, Sector **sect, Math::Vector3d *closestPoint) {
+	if (++_query == 0) {
+		for (int i = 0; i < _numSectors; i++)
+			_visited[i] = 0;
+		_query = 1;
+	}
+
+	int result = -1;
+	Math::Vector3d resultPt = p;
+	float minDist = 0.0;
+
+	for (uint i = 0; i < _unboundedSectors.size(); i++)
+		considerClosest(_unboundedSectors[i], p, result, resultPt, minDist);
+
+	float x, y;
+	getGroundCoords(p, x, y);
+	if (_cols > 0 && x == x && y == y) { // Skip the NaNs
+		// Visit the rings of cells around the cell of the point, which may be
+		// outside of the grid, until the unvisited cells are too far away to
+		// hold a closer sector. The closest point of a sector is within its
+		// cells, and the distance on the ground is not more than the real one.
+		float fcol = CLIP(floorf((x - _minX) / _cellWidth), -(float)kMaxGridSize, 2.f * kMaxGridSize);
+		float frow = CLIP(floorf((y - _minY) / _cellHeight), -(float)kMaxGridSize, 2.f * kMaxGridSize);
+		int col = (int)fcol;
+		int row = (int)frow;
+
+		int firstRing = MAX(MAX(-col, col - (_cols - 1)), MAX(-row, row - (_rows - 1)));
+		firstRing = MAX(firstRing, 0);
+		int lastRing = MAX(MAX(col, _cols - 1 - col), MAX(row, _rows - 1 - row));
+
+		for (int ring = firstRing; ring <= lastRing; ring++) {
+			if (ring > 0 && result >= 0) {
+				float left = _minX + (col - ring + 1) * _cellWidth;
+				float right = _minX + (col + ring) * _cellWidth;
+				float bottom = _minY + (row - ring + 1) * _cellHeight;
+				float top = _minY + (row + ring) * _cellHeight;
+				float bound = MIN(MIN(x - left, right - x), MIN(y - bottom, top - y));
+				if (bound > minDist)
+					break;
+			}
+
+			int row0 = MAX(row - ring, 0), row1 = MIN(row + ring, _rows - 1);
+			int col0 = MAX(col - ring, 0), col1 = MIN(col + ring, _cols - 1);
+			for (int r = row0; r <= row1; r++) {
+				if (r == row - ring || r == row + ring) {
+					for (int c = col0; c <= col1; c++)
+						considerCell(r * _cols + c, p, result, resultPt, minDist);
+				} else {
+					// Only the ends of the inner rows are on the ring
+					if (col - ring >= 0)
+						considerCell(r * _cols + col - ring, p, result, resultPt, minDist);
+					if (col + ring < _cols)
+						considerCell(r * _cols + col + ring, p, result, resultPt, minDist);
+				}
+			}
+		}
+	}
+
+	if (sect)
+		*sect = result >= 0 ? _sectors[result] : NULL;
+
+	if (closestPoint)
+		*closestPoint = resultPt;
+}
+
 } // end of namespace Grim
@@ -23,6 +23,7 @@
 #ifndef GRIM_WALKPLANE_H
 #define GRIM_WALKPLANE_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/list.h"
 
@@ -89,6 +90,7 @@ public:
 	int getNumVertices() { return _numVertices; }
 	Math::Vector3d *getVertices() { return _vertices; }
 	Math::Vector3d getNormal() { return _normal; }
+	float getHeight() const { return _height; }
 
 	Sector &operator=(const Sector &other);
 	bool operator==(const Sector &other) const;
@@ -111,6 +113,61 @@ private:
 	Math::Vector3d _normal;
 };
 
+/**
+ * Uniform grid over the sectors of a set, projected on the ground plane,
+ * to only test the sectors near a point.
+ *
+ * The sectors are filtered by type and visibility when queried, so the
+ * index only needs to be rebuilt when their shape changes.
+ */
+class SectorIndex {
+public:
+	SectorIndex();
+
+	/**
+	 * Index the sectors. The ground plane is XY, or XZ when useXZ is set.
+	 * The sectors must not be changed until the index is invalidated.
+	 */
+	void build(Sector **sectors, int numSectors, bool useXZ);
+	void invalidate() { _built = false; }
+	bool isBuilt() const { return _built; }
+
+	/** Same as Set::findPointSector(). */
+	Sector *findPointSector(const Math::Vector3d &p, Sector::SectorType type);
+
+	/** Same as Set::findClosestSector(). */
+	void findClosestSector(const Math::Vector3d &p, Sector **sect, Math::Vector3d *closestPoint);
+
+private:
+	/** Maximal number of cells in each direction. */
+	static const int kMaxGridSize = 64;
+
+	void getGroundCoords(const Math::Vector3d &p, float &x, float &y) const;
+	void getCell(float x, float y, int &col, int &row) const;
+	void considerClosest(int index, const Math::Vector3d &p, int &result, Math::Vector3d &resultPt, float &minDist);
+	void considerCell(int cell, const Math::Vector3d &p, int &result, Math::Vector3d &resultPt, float &minDist);
+
+	bool _built;
+	bool _useXZ;
+	Sector **_sectors;
+	int _numSectors;
+
+	float _minX, _minY;
+	float _cellWidth, _cellHeight;
+	int _cols, _rows;
+
+	/** The sectors of each cell, sorted by index, starting at _cellStart[cell]. */
+	Common::Array<int> _cellStart;
+	Common::Array<int> _entries;
+
+	/** The sectors whose reach can't be bounded, tested for every point. */
+	Common::Array<int> _unboundedSectors;
+
+	/** The query each sector was last considered for. */
+	Common::Array<uint32> _visited;
+	uint32 _query;
+};
+
 } // end of namespace Grim
 
 #endif
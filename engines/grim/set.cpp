@@ -36,8 +36,10 @@
 
 namespace Grim {
 
+uint32 Set::s_lightsVersion = 0;
+
 Set::Set(const Common::String &sceneName, Common::SeekableReadStream *data) :
-		_locked(false), _name(sceneName), _enableLights(false) {
+		_locked(false), _name(sceneName), _enableLights(false), _lightsVersion(0) {
 
 	char header[7];
 	data->read(header, 7);
@@ -51,7 +53,7 @@ Set::Set(const Common::String &sceneName, Common::SeekableReadStream *data) :
 }
 
 Set::Set() :
-		_cmaps(NULL) {
+		_cmaps(NULL), _lightsVersion(0) {
 
 }
 
@@ -125,8 +127,8 @@ void Set::loadText(TextSplitter &ts) {
 	for (int i = 0; i < _numLights; i++) {
 		_lights[i].load(ts);
 		_lights[i]._id = i;
-		_lightsList.push_back(&_lights[i]);
 	}
+	lightsChanged();
 
 	// Calculate the number of sectors
 	ts.expectString("section: sectors");
@@ -182,8 +184,8 @@ void Set::loadBinary(Common::SeekableReadStream *data) {
 	for (int i = 0; i < _numLights; i++) {
 		_lights[i].loadBinary(data);
 		_lights[i]._id = i;
-		_lightsList.push_back(&_lights[i]);
 	}
+	lightsChanged();
 
 	_numSectors = data->readUint32LE();
 	// Allocate and fill an array of sector info
@@ -276,14 +278,15 @@ bool Set::restoreState(SaveGame *savedState) {
 	} else {
 		_sectors = NULL;
 	}
+	_sectorIndex.invalidate();
 
 	_numLights = savedState->readLESint32();
 	_lights = new Light[_numLights];
 	for (int i = 0; i < _numLights; i++) {
 		_lights[i].restoreState(savedState);
 		_lights[i]._id = i;
-		_lightsList.push_back(&_lights[i]);
 	}
+	lightsChanged();
 
 	return true;
 }
@@ -581,35 +584,46 @@ public:
 	Math::Vector3d _pos;
 };
 
-void Set::setupLights(const Math::Vector3d &pos) {
+void Set::setupLights(const Math::Vector3d &pos, LightSelection *selection) {
 	if (!_enableLights) {
 		g_driver->disableLights();
 		return;
 	}
 
-	// Sort the ligths from the nearest to the farthest to the pos.
-	Sorter sorter(pos);
-	Common::sort(_lightsList.begin(), _lightsList.end(), sorter);
+	LightSelection temp;
+	if (!selection)
+		selection = &temp;
+
+	// Only select the lights again when they or the position changed
+	if (selection->version != _lightsVersion || selection->pos.x() != pos.x() ||
+	    selection->pos.y() != pos.y() || selection->pos.z() != pos.z()) {
+		selection->version = _lightsVersion;
+		selection->pos = pos;
+		selection->lights.clear();
+		for (int i = 0; i < _numLights; ++i) {
+			if (_lights[i]._enabled)
+				selection->lights.push_back(&_lights[i]);
+		}
 
-	int count = 0;
-	foreach (Light *l, _lightsList) {
-		if (l->_enabled) {
-			g_driver->setupLight(l, count);
-			++count;
+		// Keep the nearest lights to the pos, if the renderer can't use them all
+		uint maxLights = MAX(g_driver->getMaxLights(), 0);
+		if (selection->lights.size() > maxLights) {
+			Sorter sorter(pos);
+			Common::sort(selection->lights.begin(), selection->lights.end(), sorter);
+			selection->lights.resize(maxLights);
 		}
 	}
+
+	g_driver->setupLights(selection->lights.begin(), selection->lights.size(), _lightsVersion);
 }
 
 void Set::turnOffLights() {
 	_enableLights = false;
-	int count = 0;
-	for (int i = 0; i < _numLights; i++) {
-		Light *l = &_lights[i];
-		if (l->_enabled) {
-			g_driver->turnOffLight(count);
-			++count;
-		}
-	}
+	g_driver->setupLights(NULL, 0, _lightsVersion);
+}
+
+void Set::lightsChanged() {
+	_lightsVersion = ++s_lightsVersion;
 }
 
 void Set::setSetup(int num) {
@@ -649,38 +663,18 @@ void Set::drawBitmaps(ObjectState::Position stage) {
 	}
 }
 
+SectorIndex &Set::getSectorIndex() {
+	if (!_sectorIndex.isBuilt())
+		_sectorIndex.build(_sectors, _numSectors, g_grim->getGameType() == GType_MONKEY4);
+	return _sectorIndex;
+}
+
 Sector *Set::findPointSector(const Math::Vector3d &p, Sector::SectorType type) {
-	for (int i = 0; i < _numSectors; i++) {
-		Sector *sector = _sectors[i];
-		if (sector && (sector->getType() & type) && sector->isVisible() && sector->isPointInSector(p))
-			return sector;
-	}
-	return NULL;
+	return getSectorIndex().findPointSector(p, type);
 }
 
 void Set::findClosestSector(const Math::Vector3d &p, Sector **sect, Math::Vector3d *closestPoint) {
-	Sector *resultSect = NULL;
-	Math::Vector3d resultPt = p;
-	float minDist = 0.0;
-
-	for (int i = 0; i < _numSectors; i++) {
-		Sector *sector = _sectors[i];
-		if ((sector->getType() & Sector::WalkType) == 0 || !sector->isVisible())
-			continue;
-		Math::Vector3d closestPt = sector->getClosestPoint(p);
-		float thisDist = (closestPt - p).getMagnitude();
-		if (!resultSect || thisDist < minDist) {
-			resultSect = sector;
-			resultPt = closestPt;
-			minDist = thisDist;
-		}
-	}
-
-	if (sect)
-		*sect = resultSect;
-
-	if (closestPoint)
-		*closestPoint = resultPt;
+	getSectorIndex().findClosestSector(p, sect, closestPoint);
 }
 
 void Set::shrinkBoxes(float radius) {
@@ -688,6 +682,7 @@ void Set::shrinkBoxes(float radius) {
 		Sector *sector = _sectors[i];
 		sector->shrink(radius);
 	}
+	_sectorIndex.invalidate();
 }
 
 void Set::unshrinkBoxes() {
@@ -695,6 +690,7 @@ void Set::unshrinkBoxes() {
 		Sector *sector = _sectors[i];
 		sector->unshrink();
 	}
+	_sectorIndex.invalidate();
 }
 
 void Set::setLightIntensity(const char *light, float intensity) {
@@ -702,6 +698,7 @@ void Set::setLightIntensity(const char *light, float intensity) {
 		Light &l = _lights[i];
 		if (l._name == light) {
 			l._intensity = intensity;
+			lightsChanged();
 			return;
 		}
 	}
@@ -710,6 +707,7 @@ void Set::setLightIntensity(const char *light, float intensity) {
 void Set::setLightIntensity(int light, float intensity) {
 	Light &l = _lights[light];
 	l._intensity = intensity;
+	lightsChanged();
 }
 
 void Set::setLightEnabled(const char *light, bool enabled) {
@@ -717,6 +715,7 @@ void Set::setLightEnabled(const char *light, bool enabled) {
 		Light &l = _lights[i];
 		if (l._name == light) {
 			l._enabled = enabled;
+			lightsChanged();
 			return;
 		}
 	}
@@ -725,6 +724,7 @@ void Set::setLightEnabled(const char *light, bool enabled) {
 void Set::setLightEnabled(int light, bool enabled) {
 	Light &l = _lights[light];
 	l._enabled = enabled;
+	lightsChanged();
 }
 
 void Set::setLightPosition(const char *light, const Math::Vector3d &pos) {
@@ -732,6 +732,7 @@ void Set::setLightPosition(const char *light, const Math::Vector3d &pos) {
 		Light &l = _lights[i];
 		if (l._name == light) {
 			l._pos = pos;
+			lightsChanged();
 			return;
 		}
 	}
@@ -740,6 +741,7 @@ void Set::setLightPosition(const char *light, const Math::Vector3d &pos) {
 void Set::setLightPosition(int light, const Math::Vector3d &pos) {
 	Light &l = _lights[light];
 	l._pos = pos;
+	lightsChanged();
 }
 
 void Set::setSoundPosition(const char *soundName, const Math::Vector3d &pos) {
@@ -38,6 +38,18 @@ class SaveGame;
 class CMap;
 class Light;
 
+/**
+ * The lights Set::setupLights() chose for a position.
+ */
+struct LightSelection {
+	LightSelection() : version(0) {}
+
+	/** The version of the lights of the set when they were chosen. */
+	uint32 version;
+	Math::Vector3d pos;
+	Common::Array<Light *> lights;
+};
+
 class Set : public PoolObject<Set> {
 public:
 	Set(const Common::String &name, Common::SeekableReadStream *data);
@@ -61,7 +73,12 @@ public:
 		_currSetup->setupCamera();
 	}
 
-	void setupLights(const Math::Vector3d &pos);
+	/**
+	 * Set up the lights for drawing something at pos. The selection is
+	 * filled with the lights used, and can be passed again to skip choosing
+	 * them when neither the position nor the lights changed.
+	 */
+	void setupLights(const Math::Vector3d &pos, LightSelection *selection = NULL);
 
 	void setSoundPosition(const char *soundName, const Math::Vector3d &pos);
 	void setSoundPosition(const char *soundName, const Math::Vector3d &pos, int minVol, int maxVol);
@@ -131,6 +148,9 @@ public:
 	Setup *getCurrSetup() { return _currSetup; }
 
 private:
+	SectorIndex &getSectorIndex();
+	void lightsChanged();
+
 	bool _locked;
 	Common::String _name;
 	int _numCmaps;
@@ -138,8 +158,10 @@ private:
 	int _numSetups, _numLights, _numSectors, _numObjectStates;
 	bool _enableLights;
 	Sector **_sectors;
+	SectorIndex _sectorIndex;
 	Light *_lights;
-	Common::List<Light *> _lightsList;
+	uint32 _lightsVersion;
+	static uint32 s_lightsVersion;
 	Setup *_setups;
 
 	Setup *_currSetup;
@@ -21,6 +21,7 @@
  */
 
 #include "engines/myst3/console.h"
+#include "engines/myst3/framelimiter.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/inventory.h"
 #include "engines/myst3/script.h"
@@ -40,11 +41,18 @@ Console::Console(Myst3Engine *vm) : GUI::Debugger(), _vm(vm) {
 	DCmd_Register("fillInventory",		WRAP_METHOD(Console, Cmd_FillInventory));
 	DCmd_Register("dumpArchive",		WRAP_METHOD(Console, Cmd_DumpArchive));
 	DCmd_Register("dumpMasks",			WRAP_METHOD(Console, Cmd_DumpMasks));
+	DCmd_Register("opcodeStats",		WRAP_METHOD(Console, Cmd_OpcodeStats));
+	DCmd_Register("frameStats",			WRAP_METHOD(Console, Cmd_FrameStats));
 }
 
 Console::~Console() {
 }
 
+bool Console::showProfilerOverlay(bool show) {
+	_vm->_showProfiler = show;
+	return true;
+}
+
 void Console::describeScript(const Common::Array<Opcode> &script) {
 	for(uint j = 0; j < script.size(); j++) {
 		DebugPrintf("%s", _vm->_scriptEngine->describeOpcode(script[j]).c_str());
@@ -359,4 +367,65 @@ bool Console::Cmd_DumpMasks(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_OpcodeStats(int argc, const char **argv) {
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			_vm->_scriptEngine->resetCommandStats();
+			_vm->_scriptEngine->setProfiling(true);
+			return true;
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			_vm->_scriptEngine->setProfiling(false);
+			return true;
+		} else if (!scumm_stricmp(argv[1], "reset")) {
+			_vm->_scriptEngine->resetCommandStats();
+			return true;
+		}
+	}
+
+	if (argc != 1) {
+		DebugPrintf("Usage :\n");
+		DebugPrintf("opcodeStats : List the executed opcodes\n");
+		DebugPrintf("opcodeStats on|off : Enable / disable opcode timing\n");
+		DebugPrintf("opcodeStats reset : Clear the opcode counters\n");
+		return true;
+	}
+
+	if (_vm->_scriptEngine->isProfiling())
+		DebugPrintf("     Count          Time  Opcode\n");
+	else
+		DebugPrintf("     Count  Opcode\n");
+
+	DebugPrintf("%s", _vm->_scriptEngine->describeCommandStats().c_str());
+
+	return true;
+}
+
+bool Console::Cmd_FrameStats(int argc, const char **argv) {
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_vm->_frameLimiter->resetStats();
+		return true;
+	}
+
+	if (argc == 2) {
+		uint framerate = atoi(argv[1]);
+		if (framerate > 0) {
+			_vm->_frameLimiter->setFramerate(framerate);
+			_vm->_frameLimiter->resetStats();
+			return true;
+		}
+	}
+
+	if (argc != 1) {
+		DebugPrintf("Usage :\n");
+		DebugPrintf("frameStats : Show the frame time histogram\n");
+		DebugPrintf("frameStats reset : Clear the frame statistics\n");
+		DebugPrintf("frameStats [fps] : Change the target frame rate\n");
+		return true;
+	}
+
+	DebugPrintf("%s", _vm->_frameLimiter->describeStats().c_str());
+
+	return true;
+}
+
 } /* namespace Myst3 */
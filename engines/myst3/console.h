@@ -37,6 +37,9 @@ public:
 	Console(Myst3Engine *vm);
 	virtual ~Console();
 
+protected:
+	virtual bool showProfilerOverlay(bool show);
+
 private:
 	Myst3Engine *_vm;
 
@@ -53,6 +56,8 @@ private:
 	bool Cmd_DumpArchive(int argc, const char **argv);
 	bool Cmd_DumpMasks(int argc, const char **argv);
 	bool Cmd_FillInventory(int argc, const char **argv);
+	bool Cmd_OpcodeStats(int argc, const char **argv);
+	bool Cmd_FrameStats(int argc, const char **argv);
 };
 
 } /* namespace Myst3 */
@@ -23,11 +23,13 @@
 #include "engines/myst3/database.h"
 #include "engines/myst3/myst3.h"
 
+#include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/hashmap.h"
 #include "common/md5.h"
 #include "common/memstream.h"
+#include "common/savefile.h"
 #include "common/substream.h"
 #include "common/winexe_pe.h"
 
@@ -37,7 +39,10 @@ Database::Database(Myst3Engine *vm) :
 		_vm(vm),
 		_currentRoomID(0),
 		_executableVersion(0),
-		_currentRoomData(0) {
+		_currentRoomData(0),
+		_datImage(0),
+		_datImageSize(0),
+		_datBigEndian(false) {
 
 	_executableVersion = _vm->getExecutableVersion();
 
@@ -47,6 +52,10 @@ Database::Database(Myst3Engine *vm) :
 		error("Could not find any executable to load");
 	}
 
+	// Decrypt / decompress the executable once, all the reads
+	// are then done from memory
+	decodeDatabaseFile();
+
 	// Load the ages and rooms description
 	Common::SeekableSubReadStreamEndian *file = openDatabaseFile();
 	file->seek(_executableVersion->ageTableOffset);
@@ -81,29 +90,49 @@ Database::Database(Myst3Engine *vm) :
 	preloadCommonRooms();
 }
 
+Database::~Database() {
+	free(_datImage);
+}
+
 void Database::preloadCommonRooms() {
 	// XXXX, MENU, JRNL
 	static const uint32 commonRooms[3] = { 101, 901, 902 };
 
 	for (uint i = 0; i < 3; i++) {
-		RoomData *data = findRoomData(commonRooms[i]);
-		_roomNodesCache.setVal(commonRooms[i], loadRoomScripts(data));
+		getRoomIndex(commonRooms[i]);
 	}
 }
 
-Common::Array<uint16> Database::listRoomNodes(uint32 roomID, uint32 ageID) {
-	Common::Array<NodePtr> nodes;
-	Common::Array<uint16> list;
+Database::RoomNodes &Database::getRoomIndex(uint32 roomID) {
+	if (_roomNodesCache.contains(roomID))
+		return _roomNodesCache.getVal(roomID);
+
+	RoomData *data = findRoomData(roomID);
+	if (!data)
+		return _emptyRoom;
+
+	RoomNodes &room = _roomNodesCache[roomID];
+	room.nodes = loadRoomScripts(data);
 
+	for (uint i = 0; i < room.nodes.size(); i++) {
+		// The first node with a given id wins
+		if (!room.nodesById.contains(room.nodes[i]->id))
+			room.nodesById.setVal(room.nodes[i]->id, room.nodes[i]);
+	}
+
+	return room;
+}
+
+const Common::Array<NodePtr> &Database::getRoomNodes(uint32 roomID) {
 	if (roomID == 0)
 		roomID = _currentRoomID;
 
-	if (_roomNodesCache.contains(roomID)) {
-		nodes = _roomNodesCache.getVal(roomID);
-	} else {
-		RoomData *data = findRoomData(roomID);
-		nodes = loadRoomScripts(data);
-	}
+	return getRoomIndex(roomID).nodes;
+}
+
+Common::Array<uint16> Database::listRoomNodes(uint32 roomID, uint32 ageID) {
+	const Common::Array<NodePtr> &nodes = getRoomNodes(roomID);
+	Common::Array<uint16> list;
 
 	for (uint i = 0; i < nodes.size(); i++) {
 		list.push_back(nodes[i]->id);
@@ -113,24 +142,11 @@ Common::Array<uint16> Database::listRoomNodes(uint32 roomID, uint32 ageID) {
 }
 
 NodePtr Database::getNodeData(uint16 nodeID, uint32 roomID, uint32 ageID) {
-	Common::Array<NodePtr> nodes;
-
 	if (roomID == 0)
 		roomID = _currentRoomID;
 
-	if (_roomNodesCache.contains(roomID)) {
-		nodes = _roomNodesCache.getVal(roomID);
-	} else {
-		RoomData *data = findRoomData(roomID);
-		nodes = loadRoomScripts(data);
-	}
-
-	for (uint i = 0; i < nodes.size(); i++) {
-		if (nodes[i]->id == nodeID)
-			return nodes[i];
-	}
-
-	return NodePtr();
+	const RoomNodes &room = getRoomIndex(roomID);
+	return room.nodesById.getVal(nodeID, NodePtr());
 }
 
 RoomData *Database::findRoomData(const uint32 & roomID)
@@ -187,6 +203,7 @@ void Database::loadRoomNodeScripts(Common::SeekableSubReadStreamEndian *file, Co
 			node->id = id;
 			node->scripts = loadCondScripts(*file);
 			node->hotspots = loadHotspots(*file);
+			node->hotspotIndex.build(node->hotspots);
 
 			nodes.push_back(node);
 		} else {
@@ -200,11 +217,15 @@ void Database::loadRoomNodeScripts(Common::SeekableSubReadStreamEndian *file, Co
 			Common::Array<CondScript> scripts = loadCondScripts(*file);
 			Common::Array<HotSpot> hotspots = loadHotspots(*file);
 
+			HotSpotIndex hotspotIndex;
+			hotspotIndex.build(hotspots);
+
 			for (int i = 0; i < -id; i++) {
 				NodePtr node = NodePtr(new NodeData());
 				node->id = nodeIds[i];
 				node->scripts = scripts;
 				node->hotspots = hotspots;
+				node->hotspotIndex = hotspotIndex;
 
 				nodes.push_back(node);
 			}
@@ -301,9 +322,9 @@ void Database::setCurrentRoom(const uint32 roomID) {
 	if (!_currentRoomData || !_currentRoomData->scriptsOffset)
 		return;
 
-	// Remove old room from cache and add the new one
-	_roomNodesCache.erase(_currentRoomID);
-	_roomNodesCache.setVal(roomID, loadRoomScripts(_currentRoomData));
+	// Rooms stay in the index once loaded, so that coming back
+	// to a previously visited room does not parse it again
+	getRoomIndex(roomID);
 
 	_currentRoomID = roomID;
 }
@@ -513,19 +534,41 @@ uint32 Database::getAgeLabelId(uint32 ageID) {
 	return 0;
 }
 
-Common::SeekableSubReadStreamEndian *Database::openDatabaseFile() const {
+void Database::decodeDatabaseFile() {
 	assert(_executableVersion);
 
 	Common::SeekableReadStream *stream = SearchMan.createReadStreamForMember(_executableVersion->executable);
-	bool bigEndian = false;
+	if (!stream)
+		error("Unable to open executable %s", _executableVersion->executable);
+
+	// Decrypting the SafeDisc executables is slow, optionally keep
+	// the decoded data in a cache file alongside the saved games.
+	// The cache is only used for the exact same executable.
+	bool useCache = ConfMan.getBool("database_cache");
+	Common::String cacheName = Common::String::format("%s.m3db", ConfMan.getActiveDomainName().c_str());
+	Common::String sourceMD5;
+
+	if (useCache) {
+		sourceMD5 = Common::computeStreamMD5AsString(*stream);
+		stream->seek(0);
+		useCache = !sourceMD5.empty();
+
+		if (useCache && loadDatabaseCache(cacheName, sourceMD5)) {
+			delete stream;
+			return;
+		}
+	}
+
+	_datBigEndian = false;
 
 	if (_vm->getPlatform() == Common::kPlatformMacintosh) {
 		// The data we need is always in segment 1
 		Common::SeekableReadStream *segment = decompressPEFDataSegment(stream, 1);
 		delete stream;
 		stream = segment;
-		bigEndian = true;
+		_datBigEndian = true;
 	} else if (_vm->getDefaultLanguage() == Common::RU_RUS) {
+		// The PE resources parser takes ownership of the executable stream
 		stream = extractRussianM3R(stream);
 	} else if (_executableVersion->safeDiskKey) {
 #ifdef USE_SAFEDISC
@@ -548,7 +591,87 @@ Common::SeekableSubReadStreamEndian *Database::openDatabaseFile() const {
 #endif // USE_SAFEDISC
 	}
 
-	return new Common::SeekableSubReadStreamEndian(stream, 0, stream->size(), bigEndian, DisposeAfterUse::YES);
+	_datImageSize = stream->size();
+	_datImage = (byte *)malloc(_datImageSize);
+	stream->seek(0);
+	stream->read(_datImage, _datImageSize);
+	delete stream;
+
+	if (useCache)
+		saveDatabaseCache(cacheName, sourceMD5);
+}
+
+static const uint32 kDatabaseCacheVersion = 2;
+
+static Common::String readCacheString(Common::ReadStream *cache) {
+	Common::String str;
+	byte length = cache->readByte();
+	for (uint i = 0; i < length && !cache->eos(); i++)
+		str += (char)cache->readByte();
+
+	return str;
+}
+
+static void writeCacheString(Common::WriteStream *cache, const Common::String &str) {
+	assert(str.size() <= 255);
+	cache->writeByte(str.size());
+	cache->writeString(str);
+}
+
+bool Database::loadDatabaseCache(const Common::String &cacheName, const Common::String &sourceMD5) {
+	Common::InSaveFile *cache = _vm->getSaveFileManager()->openForLoading(cacheName);
+	if (!cache)
+		return false;
+
+	bool valid = cache->readUint32BE() == MKTAG('M', '3', 'D', 'B')
+			&& cache->readUint32LE() == kDatabaseCacheVersion
+			&& readCacheString(cache).equalsIgnoreCase(_executableVersion->executable)
+			&& readCacheString(cache) == sourceMD5;
+
+	if (valid) {
+		_datBigEndian = cache->readByte() != 0;
+		_datImageSize = cache->readUint32LE();
+		_datImage = (byte *)malloc(_datImageSize);
+		valid = cache->read(_datImage, _datImageSize) == _datImageSize && !cache->err();
+	}
+
+	delete cache;
+
+	if (!valid) {
+		warning("Ignoring invalid database cache %s", cacheName.c_str());
+		free(_datImage);
+		_datImage = 0;
+		_datImageSize = 0;
+	}
+
+	return valid;
+}
+
+void Database::saveDatabaseCache(const Common::String &cacheName, const Common::String &sourceMD5) const {
+	Common::OutSaveFile *cache = _vm->getSaveFileManager()->openForSaving(cacheName, false);
+	if (!cache)
+		return;
+
+	cache->writeUint32BE(MKTAG('M', '3', 'D', 'B'));
+	cache->writeUint32LE(kDatabaseCacheVersion);
+	writeCacheString(cache, _executableVersion->executable);
+	writeCacheString(cache, sourceMD5);
+	cache->writeByte(_datBigEndian);
+	cache->writeUint32LE(_datImageSize);
+	cache->write(_datImage, _datImageSize);
+	cache->finalize();
+
+	if (cache->err())
+		warning("Unable to write database cache %s", cacheName.c_str());
+
+	delete cache;
+}
+
+Common::SeekableSubReadStreamEndian *Database::openDatabaseFile() const {
+	assert(_datImage);
+
+	Common::SeekableReadStream *stream = new Common::MemoryReadStream(_datImage, _datImageSize, DisposeAfterUse::NO);
+	return new Common::SeekableSubReadStreamEndian(stream, 0, _datImageSize, _datBigEndian, DisposeAfterUse::YES);
 }
 
 static uint32 getPEFArgument(Common::SeekableReadStream *stream, uint &pos) {
@@ -817,14 +940,15 @@ Common::SeekableReadStream *Database::extractRussianM3R(Common::SeekableReadStre
 
 	// The uncompressed size is not stored anywhere, just allocate slightly
 	// more memory than actually needed
-	byte *data = (byte *)malloc(1100*1024);
+	static const uint32 uncompressedSize = 1100 * 1024;
+	byte *data = (byte *)malloc(uncompressedSize);
 
 	// Perform the decompression
 	NRV2D::uncompress(compressed, data);
 
 	delete compressed;
 
-	return new Common::MemoryReadStream(data, 2*1024*1024, DisposeAfterUse::YES);
+	return new Common::MemoryReadStream(data, uncompressedSize, DisposeAfterUse::YES);
 }
 
 #define ROL32(x,b) (((x) << (b)) | ((x) >> (32 - (b))))
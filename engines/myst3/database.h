@@ -44,6 +44,7 @@ struct NodeData
 	int16 id;
 	Common::Array<CondScript> scripts;
 	Common::Array<HotSpot> hotspots;
+	HotSpotIndex hotspotIndex;
 	Common::Array<CondScript> soundScripts;
 	Common::Array<CondScript> backgroundSoundScripts;
 };
@@ -84,6 +85,7 @@ public:
 	 * Initialize the database from an executable file
 	 */
 	Database(Myst3Engine *vm);
+	~Database();
 
 	/**
 	 * Loads a room's nodes into the database
@@ -115,6 +117,14 @@ public:
 	 */
 	Common::Array<uint16> listRoomNodes(uint32 roomID = 0, uint32 ageID = 0);
 
+	/**
+	 * Returns the hotspots and scripts of all the nodes of a room
+	 *
+	 * Rooms are loaded from the decoded executable on first use,
+	 * and then kept in the index.
+	 */
+	const Common::Array<NodePtr> &getRoomNodes(uint32 roomID = 0);
+
 	/**
 	 * Returns an age's label id, to be used with AGES 1000 metadata
 	 */
@@ -132,13 +142,26 @@ private:
 
 	uint32 _currentRoomID;
 	RoomData *_currentRoomData;
-	Common::HashMap< uint16, Common::Array<NodePtr> > _roomNodesCache;
+
+	struct RoomNodes {
+		Common::Array<NodePtr> nodes;
+		Common::HashMap<uint16, NodePtr> nodesById;
+	};
+
+	Common::HashMap<uint32, RoomNodes> _roomNodesCache;
+	RoomNodes _emptyRoom;
+
+	// The decrypted / decompressed executable data
+	byte *_datImage;
+	uint32 _datImageSize;
+	bool _datBigEndian;
 
 	Common::Array<Opcode> _nodeInitScript;
 
 	Common::HashMap< uint32, Common::String> _soundNames;
 
 	RoomData *findRoomData(const uint32 &roomID);
+	RoomNodes &getRoomIndex(uint32 roomID);
 	Common::Array<NodePtr> loadRoomScripts(RoomData *room);
 	void loadRoomNodeScripts(Common::SeekableSubReadStreamEndian *file, Common::Array<NodePtr> &nodes);
 	void loadRoomSoundScripts(Common::SeekableSubReadStreamEndian *file, Common::Array<NodePtr> &nodes, bool background);
@@ -156,6 +179,9 @@ private:
 
 	void loadSoundNames(Common::ReadStreamEndian *s);
 
+	void decodeDatabaseFile();
+	bool loadDatabaseCache(const Common::String &cacheName, const Common::String &sourceMD5);
+	void saveDatabaseCache(const Common::String &cacheName, const Common::String &sourceMD5) const;
 	Common::SeekableSubReadStreamEndian *openDatabaseFile() const;
 	Common::SeekableReadStream *decompressPEFDataSegment(Common::SeekableReadStream *stream, uint segmentID) const;
 	Common::SeekableReadStream *extractRussianM3R(Common::SeekableReadStream *stream) const;
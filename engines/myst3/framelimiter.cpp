@@ -0,0 +1,103 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/myst3/framelimiter.h"
+
+#include "common/util.h"
+
+namespace Myst3 {
+
+// Upper bounds of the histogram buckets, in milliseconds
+const uint32 FrameLimiter::kBucketLimits[kBucketCount] = { 4, 8, 12, 17, 20, 25, 33, 50, 100, 0xFFFFFFFF };
+
+FrameLimiter::FrameLimiter(OSystem *system, uint framerate) :
+		_system(system),
+		_frameDuration(0),
+		_frameStart(0) {
+	setFramerate(framerate);
+	resetStats();
+	_frameStart = _system->getMillis();
+}
+
+void FrameLimiter::setFramerate(uint framerate) {
+	if (framerate == 0)
+		framerate = 60;
+
+	_frameDuration = 1000 / framerate;
+}
+
+void FrameLimiter::delayBeforeNextFrame() {
+	uint32 work = _system->getMillis() - _frameStart;
+
+	if (work < _frameDuration)
+		_system->delayMillis(_frameDuration - work);
+
+	_frameStart = _system->getMillis();
+
+	_frameCount++;
+	_totalWork += work;
+	_maxWork = MAX(_maxWork, work);
+
+	for (uint i = 0; i < kBucketCount; i++) {
+		if (work < kBucketLimits[i]) {
+			_workHistogram[i]++;
+			break;
+		}
+	}
+}
+
+void FrameLimiter::resetStats() {
+	_frameCount = 0;
+	_totalWork = 0;
+	_maxWork = 0;
+	memset(_workHistogram, 0, sizeof(_workHistogram));
+}
+
+Common::String FrameLimiter::describeStats() const {
+	Common::String d = Common::String::format("Target frame time: %d ms\n", _frameDuration);
+
+	if (!_frameCount)
+		return d;
+
+	d += Common::String::format("Frames: %d, average work time: %d ms, max: %d ms\n",
+			_frameCount, _totalWork / _frameCount, _maxWork);
+
+	uint32 lowerLimit = 0;
+	for (uint i = 0; i < kBucketCount; i++) {
+		uint32 percent = _workHistogram[i] * 100 / _frameCount;
+
+		Common::String bar;
+		for (uint j = 0; j < percent / 2; j++)
+			bar += '#';
+
+		if (i == kBucketCount - 1)
+			d += Common::String::format("   >= %3d ms: %6d %3d%% %s\n", lowerLimit, _workHistogram[i], percent, bar.c_str());
+		else
+			d += Common::String::format("%3d-%3d ms: %6d %3d%% %s\n", lowerLimit, kBucketLimits[i], _workHistogram[i], percent, bar.c_str());
+
+		lowerLimit = kBucketLimits[i];
+	}
+
+	return d;
+}
+
+} // End of namespace Myst3
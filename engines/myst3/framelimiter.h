@@ -0,0 +1,74 @@
+/* ResidualVM - A 3D game interpreter
+ *
+ * ResidualVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the AUTHORS
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef MYST3_FRAMELIMITER_H
+#define MYST3_FRAMELIMITER_H
+
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Myst3 {
+
+/**
+ * Paces the frames to a target frame duration
+ *
+ * The time left in the frame budget after the game logic and the
+ * rendering is spent sleeping. The durations of the frames are
+ * collected in a histogram, for display in the console.
+ */
+class FrameLimiter {
+public:
+	FrameLimiter(OSystem *system, uint framerate);
+
+	/** Change the target frame rate */
+	void setFramerate(uint framerate);
+	uint getFrameDuration() const { return _frameDuration; }
+
+	/**
+	 * Sleep for the remaining of the frame budget.
+	 * To be called once per frame, after updating the screen.
+	 */
+	void delayBeforeNextFrame();
+
+	/** Clear the frame statistics */
+	void resetStats();
+
+	/** Describe the frame statistics, one histogram bucket per line */
+	Common::String describeStats() const;
+
+private:
+	static const uint kBucketCount = 10;
+	static const uint32 kBucketLimits[kBucketCount];
+
+	OSystem *_system;
+	uint32 _frameDuration;
+	uint32 _frameStart;
+
+	uint32 _frameCount;
+	uint32 _totalWork;
+	uint32 _maxWork;
+	uint32 _workHistogram[kBucketCount];
+};
+
+} // End of namespace Myst3
+
+#endif // MYST3_FRAMELIMITER_H
@@ -22,6 +22,9 @@
 
 #include "engines/myst3/hotspot.h"
 #include "engines/myst3/state.h"
+#include "engines/myst3/gfx.h"
+
+#include "common/util.h"
 
 namespace Myst3 {
 
@@ -78,4 +81,163 @@ bool HotSpot::isEnabled(GameState *state, uint16 var) {
 		return cursor == var;
 }
 
+HotSpotIndex::HotSpotIndex() {
+	// Cube directions are (heading, pitch) in degrees
+	_cube.left = 0;
+	_cube.top = -90;
+	_cube.cellWidth = 20;
+	_cube.cellHeight = 20;
+	_cube.cols = 360 / _cube.cellWidth;
+	_cube.rows = 180 / _cube.cellHeight;
+
+	// Frame positions are in original resolution pixels,
+	// menus use the full height of the screen
+	_frame.left = 0;
+	_frame.top = 0;
+	_frame.cellWidth = 64;
+	_frame.cellHeight = 48;
+	_frame.cols = Renderer::kOriginalWidth / _frame.cellWidth;
+	_frame.rows = Renderer::kOriginalHeight / _frame.cellHeight;
+}
+
+int16 HotSpotIndex::Grid::clampCol(int16 x) const {
+	return CLIP<int16>((x - left) / cellWidth, 0, cols - 1);
+}
+
+int16 HotSpotIndex::Grid::clampRow(int16 y) const {
+	return CLIP<int16>((y - top) / cellHeight, 0, rows - 1);
+}
+
+void HotSpotIndex::Grid::getCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const {
+	if (cellStart.empty()) {
+		candidates = 0;
+		count = 0;
+		return;
+	}
+
+	// Points outside of the grid use the border cells, which contain all
+	// the rectangles extending beyond the grid
+	uint cell = clampRow(p.y) * cols + clampCol(p.x);
+	candidates = entries.begin() + cellStart[cell];
+	count = cellStart[cell + 1] - cellStart[cell];
+}
+
+void HotSpotIndex::getCubeCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const {
+	_cube.getCandidates(p, candidates, count);
+}
+
+void HotSpotIndex::getFrameCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const {
+	_frame.getCandidates(p, candidates, count);
+}
+
+void HotSpotIndex::build(const Common::Array<HotSpot> &hotspots) {
+	Common::Array<Common::Array<CellRange> > cubeRanges;
+	Common::Array<Common::Array<CellRange> > frameRanges;
+	cubeRanges.resize(hotspots.size());
+	frameRanges.resize(hotspots.size());
+
+	for (uint i = 0; i < hotspots.size(); i++) {
+		const Common::Array<PolarRect> &rects = hotspots[i].rects;
+
+		for (uint j = 0; j < rects.size(); j++) {
+			// Same rectangles as isPointInRectsCube
+			int16 left = rects[j].centerHeading - rects[j].width / 2;
+			int16 top = rects[j].centerPitch - rects[j].height / 2;
+			int16 right = rects[j].centerHeading + rects[j].width / 2;
+			int16 bottom = rects[j].centerPitch + rects[j].height / 2;
+
+			CellRange range;
+			range.firstRow = _cube.clampRow(top);
+			range.lastRow = _cube.clampRow(bottom);
+			range.firstCol = _cube.clampCol(left);
+			range.lastCol = _cube.clampCol(right);
+			cubeRanges[i].push_back(range);
+
+			if (right > 360) {
+				// The part wrapping around to the start of the heading range
+				range.firstCol = _cube.clampCol(0);
+				range.lastCol = _cube.clampCol(right - 360);
+				cubeRanges[i].push_back(range);
+			}
+
+			// Same rectangles as isPointInRectsFrame
+			int16 x = rects[j].centerPitch;
+			int16 y = rects[j].centerHeading;
+			int16 w = rects[j].width;
+			int16 h = rects[j].height;
+
+			if (y < 0) {
+				// The position is only known at runtime
+				range.firstCol = 0;
+				range.lastCol = _frame.cols - 1;
+				range.firstRow = 0;
+				range.lastRow = _frame.rows - 1;
+			} else {
+				range.firstCol = _frame.clampCol(MIN<int16>(x, x + w));
+				range.lastCol = _frame.clampCol(MAX<int16>(x, x + w));
+				range.firstRow = _frame.clampRow(MIN<int16>(y, y + h));
+				range.lastRow = _frame.clampRow(MAX<int16>(y, y + h));
+			}
+			frameRanges[i].push_back(range);
+		}
+	}
+
+	fillGrid(_cube, cubeRanges);
+	fillGrid(_frame, frameRanges);
+}
+
+void HotSpotIndex::fillGrid(Grid &grid, const Common::Array<Common::Array<CellRange> > &ranges) {
+	uint cellCount = grid.cols * grid.rows;
+
+	// The last hotspot added to each cell, so that hotspots
+	// with overlapping rectangles are only added once
+	Common::Array<int32> lastHotspot;
+	lastHotspot.resize(cellCount);
+
+	grid.cellStart.clear();
+	grid.cellStart.resize(cellCount + 1);
+	grid.entries.clear();
+
+	// First pass to count the candidates of each cell,
+	// second pass to store them
+	for (uint pass = 0; pass < 2; pass++) {
+		for (uint i = 0; i < cellCount; i++)
+			lastHotspot[i] = -1;
+
+		for (uint i = 0; i < ranges.size(); i++) {
+			for (uint j = 0; j < ranges[i].size(); j++) {
+				const CellRange &range = ranges[i][j];
+
+				for (int16 row = range.firstRow; row <= range.lastRow; row++) {
+					for (int16 col = range.firstCol; col <= range.lastCol; col++) {
+						uint cell = row * grid.cols + col;
+						if (lastHotspot[cell] == (int32)i)
+							continue;
+
+						lastHotspot[cell] = i;
+
+						if (pass == 0)
+							grid.cellStart[cell + 1]++;
+						else
+							grid.entries[grid.cellStart[cell]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint i = 0; i < cellCount; i++)
+				grid.cellStart[i + 1] += grid.cellStart[i];
+
+			grid.entries.resize(grid.cellStart[cellCount]);
+		} else {
+			// The second pass moved each start offset to the end of its cell
+			for (uint i = cellCount; i > 0; i--)
+				grid.cellStart[i] = grid.cellStart[i - 1];
+
+			grid.cellStart[0] = 0;
+		}
+	}
+}
+
 } /* namespace Myst3 */
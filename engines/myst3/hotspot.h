@@ -59,6 +59,60 @@ public:
 	bool isEnabled(GameState *state, uint16 var = 0);
 };
 
+/**
+ * Bucket grid over the rectangles of the hotspots of a node
+ *
+ * Used to find the hotspots that may be under the cursor without
+ * testing all the hotspots of the node. The candidates of a cell are
+ * sorted by hotspot index so that the first enabled hotspot containing
+ * the cursor is still the one that is picked.
+ *
+ * Frame rectangles whose position is read from game variables are
+ * added to all the frame cells.
+ */
+class HotSpotIndex {
+public:
+	HotSpotIndex();
+
+	void build(const Common::Array<HotSpot> &hotspots);
+
+	/** Hotspots possibly containing a (heading, pitch) direction */
+	void getCubeCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const;
+
+	/** Hotspots possibly containing a point in frame coordinates */
+	void getFrameCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const;
+
+private:
+	struct Grid {
+		int16 left;
+		int16 top;
+		int16 cellWidth;
+		int16 cellHeight;
+		int16 cols;
+		int16 rows;
+
+		/** Start offset of the candidates of each cell, with one extra end offset */
+		Common::Array<uint32> cellStart;
+		Common::Array<uint16> entries;
+
+		int16 clampCol(int16 x) const;
+		int16 clampRow(int16 y) const;
+		void getCandidates(const Common::Point &p, const uint16 *&candidates, uint &count) const;
+	};
+
+	struct CellRange {
+		int16 firstCol;
+		int16 lastCol;
+		int16 firstRow;
+		int16 lastRow;
+	};
+
+	static void fillGrid(Grid &grid, const Common::Array<Common::Array<CellRange> > &ranges);
+
+	Grid _cube;
+	Grid _frame;
+};
+
 
 } /* namespace Myst3 */
 #endif /* HOTSPOT_H_ */
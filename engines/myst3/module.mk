@@ -9,6 +9,7 @@ MODULE_OBJS := \
 	detection.o \
 	directoryentry.o \
 	directorysubentry.o \
+	framelimiter.o \
 	gfx.o \
 	hotspot.o \
 	inventory.o \
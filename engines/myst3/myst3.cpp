@@ -25,17 +25,20 @@
 #include "common/error.h"
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 
 #include "gui/debugger.h"
 #include "gui/error.h"
+#include "gui/EventRecorder.h"
 
 #include "engines/engine.h"
 
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
+#include "engines/myst3/framelimiter.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -70,10 +73,10 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_db(0), _console(0), _scriptEngine(0),
 		_state(0), _node(0), _scene(0), _archiveNode(0),
 		_cursor(0), _inventory(0), _gfx(0), _menu(0),
-		_rnd(0), _sound(0), _ambient(0),
+		_rnd(0), _sound(0), _ambient(0), _frameLimiter(0), _lastSoundUpdate(0),
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
-		_menuAction(0), _projectorBackground(0) {
+		_menuAction(0), _projectorBackground(0), _showProfiler(false) {
 	DebugMan.addDebugChannel(kDebugVariable, "Variable", "Track Variable Accesses");
 	DebugMan.addDebugChannel(kDebugSaveLoad, "SaveLoad", "Track Save/Load Function");
 	DebugMan.addDebugChannel(kDebugScript, "Script", "Track Script Execution");
@@ -126,6 +129,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _rnd;
 	delete _sound;
 	delete _ambient;
+	delete _frameLimiter;
 	delete _gfx;
 }
 
@@ -149,6 +153,7 @@ Common::Error Myst3Engine::run() {
 	_ambient = new Ambient(this);
 	_rnd = new Common::RandomSource("sprint");
 	_console = new Console(this);
+	_frameLimiter = new FrameLimiter(_system, ConfMan.getInt("engine_speed"));
 	_scriptEngine = new Script(this);
 	_db = new Database(this);
 	_state = new GameState(this);
@@ -336,7 +341,12 @@ HotSpot *Myst3Engine::getHoveredHotspot(NodePtr nodeData, uint16 var) {
 
 		Common::Point mouse = Common::Point((int16)heading, (int16)pitch);
 
-		for (uint j = 0; j < nodeData->hotspots.size(); j++) {
+		const uint16 *candidates;
+		uint candidateCount;
+		nodeData->hotspotIndex.getCubeCandidates(mouse, candidates, candidateCount);
+
+		for (uint i = 0; i < candidateCount; i++) {
+			uint16 j = candidates[i];
 			int32 hitRect = nodeData->hotspots[j].isPointInRectsCube(mouse);
 			if (hitRect >= 0
 					&& nodeData->hotspots[j].isEnabled(_state, var)) {
@@ -363,7 +373,12 @@ HotSpot *Myst3Engine::getHoveredHotspot(NodePtr nodeData, uint16 var) {
 							- Renderer::kTopBorderHeight, 0, Renderer::kFrameHeight));
 		}
 
-		for (uint j = 0; j < nodeData->hotspots.size(); j++) {
+		const uint16 *candidates;
+		uint candidateCount;
+		nodeData->hotspotIndex.getFrameCandidates(scaledMouse, candidates, candidateCount);
+
+		for (uint i = 0; i < candidateCount; i++) {
+			uint16 j = candidates[i];
 			int32 hitRect = nodeData->hotspots[j].isPointInRectsFrame(_state, scaledMouse);
 			if (hitRect >= 0
 					&& nodeData->hotspots[j].isEnabled(_state, var)) {
@@ -497,7 +512,25 @@ void Myst3Engine::processInput(bool lookOnly) {
 }
 
 void Myst3Engine::drawFrame() {
-	_sound->update();
+	GUI::BenchmarkScope benchmark(GUI::kBenchmarkRender);
+	PROFILE_ZONE("Myst3Engine::drawFrame");
+
+	// The sound channels and the background sound scripts run on this
+	// thread, so they are updated at most once per frame. The updates are
+	// scheduled on a fixed 20ms grid rather than 20ms after the previous
+	// one, so that on average they keep that rate when the frames are
+	// shorter. When more than an interval late, the grid restarts from now
+	// instead of catching up.
+	uint32 currentTime = _system->getMillis();
+	uint32 elapsed = currentTime - _lastSoundUpdate;
+	if (elapsed >= kSoundUpdateInterval) {
+		_sound->update();
+		if (elapsed >= 2 * kSoundUpdateInterval)
+			_lastSoundUpdate = currentTime;
+		else
+			_lastSoundUpdate += kSoundUpdateInterval;
+	}
+
 	_gfx->clear();
 
 	if (_state->getViewType() == kCube) {
@@ -558,14 +591,39 @@ void Myst3Engine::drawFrame() {
 		_node->drawOverlay();
 	}
 
+	if (_showProfiler)
+		drawProfilerOverlay();
+
 	if (_cursor->isVisible())
 		_cursor->draw();
 
 	_system->updateScreen();
-	_system->delayMillis(10);
+	_frameLimiter->delayBeforeNextFrame();
 	_state->updateFrameCounters();
 }
 
+void Myst3Engine::drawProfilerOverlay() {
+#ifdef ENABLE_ZONE_PROFILER
+	Common::Array<Common::Profiler::ZoneStats> stats;
+	Common::Profiler::instance().getStats(stats);
+
+	// The game font only has letters and digits, so the other characters
+	// of the names become spaces, and the times are drawn as min, avg and
+	// max in microseconds
+	for (uint i = 0; i < stats.size(); i++) {
+		Common::String name = stats[i].name;
+		for (uint j = 0; j < name.size(); j++) {
+			if (!Common::isAlnum(name[j]))
+				name.setChar(' ', j);
+		}
+
+		Common::String line = Common::String::format("%s %u %u %u", name.c_str(), (uint)stats[i].minMicros,
+		                                             (uint)(stats[i].totalMicros / stats[i].count), (uint)stats[i].maxMicros);
+		_gfx->draw2DText(line, Common::Point(5, 5 + i * 32));
+	}
+#endif
+}
+
 bool Myst3Engine::isInventoryVisible() {
 	if (_state->getViewType() == kMenu)
 		return false;
@@ -685,6 +743,8 @@ void Myst3Engine::runNodeInitScripts() {
 }
 
 void Myst3Engine::runNodeBackgroundScripts() {
+	GUI::BenchmarkScope benchmark(GUI::kBenchmarkScripts);
+
 	NodePtr nodeDataRoom = _db->getNodeData(32675, _state->getLocationRoom());
 
 	if (nodeDataRoom) {
@@ -1379,6 +1439,8 @@ void Myst3Engine::settingsInitDefaults() {
 	ConfMan.registerDefault("mouse_speed", 50);
 	ConfMan.registerDefault("zip_mode", false);
 	ConfMan.registerDefault("subtitles", false);
+	ConfMan.registerDefault("engine_speed", 60);
+	ConfMan.registerDefault("database_cache", false);
 }
 
 void Myst3Engine::settingsLoadToVars() {
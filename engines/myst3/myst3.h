@@ -77,6 +77,7 @@ class Renderer;
 class Menu;
 class Sound;
 class Ambient;
+class FrameLimiter;
 struct NodeData;
 struct Myst3GameDescription;
 
@@ -180,12 +181,21 @@ private:
 
 	Script *_scriptEngine;
 
+	FrameLimiter *_frameLimiter;
+
+	// Average interval between two sound updates, in milliseconds,
+	// when the frames are shorter than it
+	static const uint32 kSoundUpdateInterval = 20;
+	uint32 _lastSoundUpdate;
+
 	Common::Array<ScriptedMovie *> _movies;
 	Common::Array<SunSpot *> _sunspots;
 	Common::Array<Drawable *> _drawables;
 
 	uint16 _menuAction;
 
+	bool _showProfiler;
+
 	bool _inputSpacePressed;
 	bool _inputEnterPressed;
 	bool _inputEscapePressed;
@@ -201,6 +211,7 @@ private:
 	void closeArchives();
 
 	bool isInventoryVisible();
+	void drawProfilerOverlay();
 
 	friend class Console;
 };
@@ -35,7 +35,8 @@
 namespace Myst3 {
 
 Script::Script(Myst3Engine *vm):
-	_vm(vm) {
+	_vm(vm),
+	_profiling(false) {
 
 	_puzzles = new Puzzles(_vm);
 
@@ -260,6 +261,15 @@ Script::Script(Myst3Engine *vm):
 #undef OP_3
 #undef OP_4
 #undef OP_5
+
+	// Unknown opcodes resolve to the invalid opcode
+	for (uint i = 0; i < ARRAYSIZE(_commandTable); i++)
+		_commandTable[i] = &_commands[0];
+
+	for (uint i = 0; i < _commands.size(); i++)
+		_commandTable[_commands[i].op] = &_commands[i];
+
+	resetCommandStats();
 }
 
 Script::~Script() {
@@ -290,21 +300,57 @@ bool Script::run(const Common::Array<Opcode> *script) {
 }
 
 const Script::Command &Script::findCommand(uint16 op) {
-	for (uint16 i = 0; i < _commands.size(); i++)
-		if (_commands[i].op == op)
-			return _commands[i];
-
 	// Return the invalid opcode if not found
-	return findCommand(0);
+	if (op >= ARRAYSIZE(_commandTable))
+		return _commands[0];
+
+	return *_commandTable[op];
 }
 
 void Script::runOp(Context &c, const Opcode &op) {
-	const Script::Command &cmd = findCommand(op.op);
+	const Script::Command &cmd = *_commandTable[op.op];
+	CommandStats &stats = _commandStats[op.op];
 
-	if (cmd.op != 0)
-		(this->*(cmd.proc))(c, op);
-	else
+	stats.count++;
+
+	if (cmd.op == 0) {
 		warning("Trying to run invalid opcode %d", op.op);
+	} else if (_profiling) {
+		// Most opcodes run in a few microseconds
+		uint64 start = g_system->getMicros();
+		(this->*(cmd.proc))(c, op);
+		stats.time += g_system->getMicros() - start;
+	} else {
+		(this->*(cmd.proc))(c, op);
+	}
+}
+
+void Script::resetCommandStats() {
+	memset(_commandStats, 0, sizeof(_commandStats));
+}
+
+const Common::String Script::describeCommandStats() {
+	Common::Array<uint16> ops;
+	for (uint16 i = 0; i < ARRAYSIZE(_commandStats); i++)
+		if (_commandStats[i].count)
+			ops.push_back(i);
+
+	// Sort by decreasing execution count
+	for (uint i = 1; i < ops.size(); i++)
+		for (uint j = i; j > 0 && _commandStats[ops[j]].count > _commandStats[ops[j - 1]].count; j--)
+			SWAP(ops[j], ops[j - 1]);
+
+	Common::String d;
+	for (uint i = 0; i < ops.size(); i++) {
+		const CommandStats &stats = _commandStats[ops[i]];
+
+		if (_profiling)
+			d += Common::String::format("%10d %10.3f ms  %s\n", stats.count, stats.time / 1000.0, describeCommand(ops[i]).c_str());
+		else
+			d += Common::String::format("%10d  %s\n", stats.count, describeCommand(ops[i]).c_str());
+	}
+
+	return d;
 }
 
 const Common::String Script::describeCommand(uint16 op) {
@@ -41,6 +41,20 @@ public:
 	bool run(const Common::Array<Opcode> *script);
 	const Common::String describeOpcode(const Opcode &opcode);
 
+	/**
+	 * Enable measuring the time spent in each opcode
+	 *
+	 * Execution counts are always collected.
+	 */
+	void setProfiling(bool enabled) { _profiling = enabled; }
+	bool isProfiling() const { return _profiling; }
+
+	/** Clear the opcode execution counters */
+	void resetCommandStats();
+
+	/** List the executed opcodes, most used first */
+	const Common::String describeCommandStats();
+
 private:
 	struct Context {
 		bool endScript;
@@ -84,8 +98,20 @@ private:
 	Myst3Engine *_vm;
 	Puzzles *_puzzles;
 
+	struct CommandStats {
+		uint32 count;
+		uint64 time; ///< In microseconds
+	};
+
 	Common::Array<Command> _commands;
 
+	// Opcodes are 8 bits wide, they are dispatched
+	// by indexing this table with the opcode value
+	const Command *_commandTable[256];
+
+	CommandStats _commandStats[256];
+	bool _profiling;
+
 	const Command &findCommand(uint16 op);
 	const Common::String describeCommand(uint16 op);
 	const Common::String describeArgument(ArgumentType type, int16 value);
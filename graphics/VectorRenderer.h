@@ -273,6 +273,13 @@ public:
 		_activeSurface = surface;
 	}
 
+	/**
+	 * Returns the surface currently being drawn.
+	 */
+	Surface *getActiveSurface() const {
+		return _activeSurface;
+	}
+
 	/**
 	 * Fills the active surface with the specified fg/bg color or the active gradient.
 	 * Defaults to using the active Foreground color for filling.
@@ -485,6 +492,7 @@ public:
 	 */
 	virtual void disableShadows() { _disableShadows = true; }
 	virtual void enableShadows() { _disableShadows = false; }
+	bool shadowsEnabled() const { return !_disableShadows; }
 
 	/**
 	 * Applies a whole-screen shading effect, used before opening a new dialog.
@@ -23,6 +23,7 @@
 #include "common/util.h"
 #include "common/system.h"
 #include "common/frac.h"
+#include "common/simd.h"
 
 #include "graphics/surface.h"
 #include "graphics/colormasks.h"
@@ -30,6 +31,7 @@
 #include "gui/ThemeEngine.h"
 #include "graphics/VectorRenderer.h"
 #include "graphics/VectorRendererSpec.h"
+#include "graphics/VectorRendererSpecSIMD.h"
 
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
@@ -320,6 +322,12 @@ namespace Graphics {
 template<typename PixelType>
 void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	register int count = (last - first);
+	if (Common::hasSIMD() && count > 0) {
+		int filled = colorFillSIMD(first, count, color);
+		first += filled;
+		count -= filled;
+	}
+
 	if (!count)
 		return;
 	register int n = (count + 7) >> 3;
@@ -464,7 +472,28 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
+		int j = x;
+
+		if (Common::hasSIMD()) {
+			// The dithering pattern only depends on the parity of the column
+			PixelType colors[2];
+			for (int k = 0; k < 2; k++) {
+				bool oy = (((x + k) & 1) == 1);
+
+				if ((ox && oy) ||
+					((grad == 2 || grad == 3) && ox && !oy) ||
+					(grad == 3 && oy))
+					colors[k] = _gradCache[curGrad + 1];
+				else
+					colors[k] = _gradCache[curGrad];
+			}
+
+			int filled = ditherFillSIMD(ptr, width, colors[0], colors[1]);
+			j += filled;
+			ptr += filled;
+		}
+
+		for (; j < x + width; j++, ptr++) {
 			bool oy = ((j & 1) == 1);
 
 			if ((ox && oy) ||
@@ -674,6 +703,16 @@ blendPixelDestAlphaPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	if (Common::hasSIMD() && last > first)
+		first += blendFillSIMD(first, last - first, color, alpha, _format);
+
+	while (first != last)
+		blendPixelPtr(first++, color, alpha);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 darkenFill(PixelType *ptr, PixelType *end) {
@@ -682,6 +721,9 @@ darkenFill(PixelType *ptr, PixelType *end) {
 	if (!g_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha)) {
 		// !kFeatureOverlaySupportsAlpha (but might have alpha bits)
 
+		if (Common::hasSIMD() && end > ptr)
+			ptr += darkenFillSIMD(ptr, end - ptr, (PixelType)~mask, _alphaMask, 0);
+
 		while (ptr != end) {
 			*ptr = ((*ptr & ~mask) >> 2) | _alphaMask;
 			++ptr;
@@ -694,6 +736,9 @@ darkenFill(PixelType *ptr, PixelType *end) {
 		PixelType addA = (PixelType)(255 >> _format.aLoss) << _format.aShift;
 		addA -= (addA >> 2);
 
+		if (Common::hasSIMD() && end > ptr)
+			ptr += darkenFillSIMD(ptr, end - ptr, (PixelType)~mask, 0, addA);
+
 		while (ptr != end) {
 			// Darken the colour, and increase the alpha
 			// (0% -> 75%, 100% -> 100%)
@@ -1846,9 +1891,7 @@ drawSquareShadow(int x, int y, int w, int h, int offset) {
 	ptr = (PixelType *)_activeSurface->getBasePtr(x + offset, y + h - 1);
 
 	while (i++ < offset) {
-		j = w - offset;
-		while (j--)
-			blendPixelPtr(ptr + j, 0, ((offset - i) << 8) / offset);
+		blendFill(ptr, ptr + w - offset, 0, ((offset - i) << 8) / offset);
 		ptr += pitch;
 	}
 
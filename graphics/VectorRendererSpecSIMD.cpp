@@ -0,0 +1,249 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/simd.h"
+
+#include "graphics/VectorRendererSpecSIMD.h"
+
+namespace Graphics {
+
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+
+// The vectors hold 16 bytes: 8 pixels of 16 bits or 4 pixels of 32 bits.
+// Blending is done on 16 bit lanes as (d * (256 - alpha) + s * alpha) >> 8,
+// which equals d + (((s - d) * alpha) >> 8) as computed by the scalar
+// code, without overflowing.
+
+#if defined(SCUMMVM_SSE2)
+
+typedef __m128i Vec;
+
+static FORCEINLINE Vec vLoad(const void *src) { return _mm_loadu_si128((const __m128i *)src); }
+static FORCEINLINE void vStore(void *dst, Vec v) { _mm_storeu_si128((__m128i *)dst, v); }
+static FORCEINLINE Vec vSet16(uint16 x) { return _mm_set1_epi16((int16)x); }
+static FORCEINLINE Vec vSet32(uint32 x) { return _mm_set1_epi32((int32)x); }
+static FORCEINLINE Vec vAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+static FORCEINLINE Vec vOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+static FORCEINLINE Vec vAdd16(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+static FORCEINLINE Vec vAdd32(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+static FORCEINLINE Vec vMul16(Vec a, Vec b) { return _mm_mullo_epi16(a, b); }
+static FORCEINLINE Vec vShl16(Vec a, int n) { return _mm_sll_epi16(a, _mm_cvtsi32_si128(n)); }
+static FORCEINLINE Vec vShr16(Vec a, int n) { return _mm_srl_epi16(a, _mm_cvtsi32_si128(n)); }
+static FORCEINLINE Vec vShr32(Vec a, int n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+
+// Zero extend the low (resp. high) 8 bytes to 16 bit lanes
+static FORCEINLINE Vec vWidenLo8(Vec a) { return _mm_unpacklo_epi8(a, _mm_setzero_si128()); }
+static FORCEINLINE Vec vWidenHi8(Vec a) { return _mm_unpackhi_epi8(a, _mm_setzero_si128()); }
+
+// Narrow 16 bit lanes holding values in [0, 255] back to bytes
+static FORCEINLINE Vec vNarrow16(Vec lo, Vec hi) { return _mm_packus_epi16(lo, hi); }
+
+#elif defined(SCUMMVM_NEON)
+
+typedef uint16x8_t Vec;
+
+static FORCEINLINE Vec vLoad(const void *src) { return vreinterpretq_u16_u8(vld1q_u8((const uint8 *)src)); }
+static FORCEINLINE void vStore(void *dst, Vec v) { vst1q_u8((uint8 *)dst, vreinterpretq_u8_u16(v)); }
+static FORCEINLINE Vec vSet16(uint16 x) { return vdupq_n_u16(x); }
+static FORCEINLINE Vec vSet32(uint32 x) { return vreinterpretq_u16_u32(vdupq_n_u32(x)); }
+static FORCEINLINE Vec vAnd(Vec a, Vec b) { return vandq_u16(a, b); }
+static FORCEINLINE Vec vOr(Vec a, Vec b) { return vorrq_u16(a, b); }
+static FORCEINLINE Vec vAdd16(Vec a, Vec b) { return vaddq_u16(a, b); }
+static FORCEINLINE Vec vAdd32(Vec a, Vec b) { return vreinterpretq_u16_u32(vaddq_u32(vreinterpretq_u32_u16(a), vreinterpretq_u32_u16(b))); }
+static FORCEINLINE Vec vMul16(Vec a, Vec b) { return vmulq_u16(a, b); }
+static FORCEINLINE Vec vShl16(Vec a, int n) { return vshlq_u16(a, vdupq_n_s16(n)); }
+static FORCEINLINE Vec vShr16(Vec a, int n) { return vshlq_u16(a, vdupq_n_s16(-n)); }
+static FORCEINLINE Vec vShr32(Vec a, int n) { return vreinterpretq_u16_u32(vshlq_u32(vreinterpretq_u32_u16(a), vdupq_n_s32(-n))); }
+
+static FORCEINLINE Vec vWidenLo8(Vec a) { return vmovl_u8(vget_low_u8(vreinterpretq_u8_u16(a))); }
+static FORCEINLINE Vec vWidenHi8(Vec a) { return vmovl_u8(vget_high_u8(vreinterpretq_u8_u16(a))); }
+static FORCEINLINE Vec vNarrow16(Vec lo, Vec hi) { return vreinterpretq_u16_u8(vcombine_u8(vmovn_u16(lo), vmovn_u16(hi))); }
+
+#endif
+
+int colorFillSIMD(uint16 *ptr, int count, uint16 color) {
+	const Vec c = vSet16(color);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+		vStore(ptr + i, c);
+
+	return i;
+}
+
+int colorFillSIMD(uint32 *ptr, int count, uint32 color) {
+	const Vec c = vSet32(color);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+		vStore(ptr + i, c);
+
+	return i;
+}
+
+int ditherFillSIMD(uint16 *ptr, int count, uint16 color1, uint16 color2) {
+	const uint16 pattern[8] = { color1, color2, color1, color2, color1, color2, color1, color2 };
+	const Vec c = vLoad(pattern);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+		vStore(ptr + i, c);
+
+	return i;
+}
+
+int ditherFillSIMD(uint32 *ptr, int count, uint32 color1, uint32 color2) {
+	const uint32 pattern[4] = { color1, color2, color1, color2 };
+	const Vec c = vLoad(pattern);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+		vStore(ptr + i, c);
+
+	return i;
+}
+
+int blendFillSIMD(uint16 *ptr, int count, uint16 color, uint8 alpha, const PixelFormat &format) {
+	const int shifts[3] = { format.rShift, format.gShift, format.bShift };
+	const int losses[3] = { format.rLoss, format.gLoss, format.bLoss };
+
+	// Each channel is blended at the bottom of its lane, then put back in place.
+	// Masking the blended value with the channel mask as the scalar code does
+	// is the same as blending the channel without the bits below it.
+	Vec channelMask[3], srcTerm[3];
+	for (int c = 0; c < 3; c++) {
+		const uint16 mask = 0xFF >> losses[c];
+		channelMask[c] = vSet16(mask);
+		srcTerm[c] = vSet16(((color >> shifts[c]) & mask) * alpha);
+	}
+
+	const Vec alphaMask = vSet16((0xFF >> format.aLoss) << format.aShift);
+	const Vec invAlpha = vSet16(256 - alpha);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const Vec dst = vLoad(ptr + i);
+		Vec out = vAnd(dst, alphaMask);
+
+		for (int c = 0; c < 3; c++) {
+			Vec d = vAnd(vShr16(dst, shifts[c]), channelMask[c]);
+			d = vShr16(vAdd16(vMul16(d, invAlpha), srcTerm[c]), 8);
+			out = vOr(out, vShl16(d, shifts[c]));
+		}
+
+		vStore(ptr + i, out);
+	}
+
+	return i;
+}
+
+int blendFillSIMD(uint32 *ptr, int count, uint32 color, uint8 alpha, const PixelFormat &format) {
+	// Blend the channels as bytes, which requires full bytes in their place
+	if (format.rLoss || format.gLoss || format.bLoss
+			|| (format.rShift & 7) || (format.gShift & 7) || (format.bShift & 7))
+		return 0;
+
+	const uint32 colorBits = (0xFFU << format.rShift) | (0xFFU << format.gShift) | (0xFFU << format.bShift);
+	const Vec colorMask = vSet32(colorBits);
+	const Vec alphaMask = vSet32((0xFFU >> format.aLoss) << format.aShift);
+	const Vec invAlpha = vSet16(256 - alpha);
+
+	// All the pixels of the source are the same, so both halves are too
+	const Vec srcTerm = vMul16(vWidenLo8(vSet32(color)), vSet16(alpha));
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const Vec dst = vLoad(ptr + i);
+		const Vec lo = vShr16(vAdd16(vMul16(vWidenLo8(dst), invAlpha), srcTerm), 8);
+		const Vec hi = vShr16(vAdd16(vMul16(vWidenHi8(dst), invAlpha), srcTerm), 8);
+
+		vStore(ptr + i, vOr(vAnd(vNarrow16(lo, hi), colorMask), vAnd(dst, alphaMask)));
+	}
+
+	return i;
+}
+
+int darkenFillSIMD(uint16 *ptr, int count, uint16 keepMask, uint16 orBits, uint16 addBits) {
+	const Vec keep = vSet16(keepMask);
+	const Vec orVec = vSet16(orBits);
+	const Vec add = vSet16(addBits);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const Vec dst = vLoad(ptr + i);
+		vStore(ptr + i, vAdd16(vOr(vShr16(vAnd(dst, keep), 2), orVec), add));
+	}
+
+	return i;
+}
+
+int darkenFillSIMD(uint32 *ptr, int count, uint32 keepMask, uint32 orBits, uint32 addBits) {
+	const Vec keep = vSet32(keepMask);
+	const Vec orVec = vSet32(orBits);
+	const Vec add = vSet32(addBits);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const Vec dst = vLoad(ptr + i);
+		vStore(ptr + i, vAdd32(vOr(vShr32(vAnd(dst, keep), 2), orVec), add));
+	}
+
+	return i;
+}
+
+#else
+
+int colorFillSIMD(uint16 *, int, uint16) {
+	return 0;
+}
+
+int colorFillSIMD(uint32 *, int, uint32) {
+	return 0;
+}
+
+int ditherFillSIMD(uint16 *, int, uint16, uint16) {
+	return 0;
+}
+
+int ditherFillSIMD(uint32 *, int, uint32, uint32) {
+	return 0;
+}
+
+int blendFillSIMD(uint16 *, int, uint16, uint8, const PixelFormat &) {
+	return 0;
+}
+
+int blendFillSIMD(uint32 *, int, uint32, uint8, const PixelFormat &) {
+	return 0;
+}
+
+int darkenFillSIMD(uint16 *, int, uint16, uint16, uint16) {
+	return 0;
+}
+
+int darkenFillSIMD(uint32 *, int, uint32, uint32, uint32) {
+	return 0;
+}
+
+#endif
+
+} // End of namespace Graphics
@@ -0,0 +1,72 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/**
+ * @file
+ * Vectorized row kernels for VectorRendererSpec.
+ *
+ * The kernels produce exactly the same pixels as the scalar code of the
+ * renderer. They only handle as many whole vectors as fit in the row and
+ * return the number of pixels they processed; the caller processes the
+ * remaining pixels with the scalar code. They return 0 when no vectorized
+ * path is available for the pixel format.
+ */
+
+#ifndef GRAPHICS_VECTORRENDERERSPECSIMD_H
+#define GRAPHICS_VECTORRENDERERSPECSIMD_H
+
+#include "common/scummsys.h"
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * Fill pixels with a color.
+ */
+int colorFillSIMD(uint16 *ptr, int count, uint16 color);
+int colorFillSIMD(uint32 *ptr, int count, uint32 color);
+
+/**
+ * Fill pixels alternating between two colors, starting with the first
+ * one. Used for the dithered rows of the gradients.
+ */
+int ditherFillSIMD(uint16 *ptr, int count, uint16 color1, uint16 color2);
+int ditherFillSIMD(uint32 *ptr, int count, uint32 color1, uint32 color2);
+
+/**
+ * Blend a color with a constant alpha over pixels, like
+ * VectorRendererSpec::blendPixelPtr(). The alpha bits of the pixels are
+ * kept and their unused bits cleared.
+ */
+int blendFillSIMD(uint16 *ptr, int count, uint16 color, uint8 alpha, const PixelFormat &format);
+int blendFillSIMD(uint32 *ptr, int count, uint32 color, uint8 alpha, const PixelFormat &format);
+
+/**
+ * Set pixels to (((pixel & keepMask) >> 2) | orBits) + addBits, which
+ * is how VectorRendererSpec::darkenFill() darkens shadowed areas.
+ */
+int darkenFillSIMD(uint16 *ptr, int count, uint16 keepMask, uint16 orBits, uint16 addBits);
+int darkenFillSIMD(uint32 *ptr, int count, uint32 keepMask, uint32 orBits, uint32 addBits);
+
+} // End of namespace Graphics
+
+#endif
@@ -15,8 +15,10 @@ MODULE_OBJS := \
 	thumbnail.o \
 	VectorRenderer.o \
 	VectorRendererSpec.o \
+	VectorRendererSpecSIMD.o \
 	yuv_to_rgb.o \
 	yuva_to_rgba.o \
+	yuv_to_rgb_simd.o \
 	decoders/bmp.o \
 	decoders/jpeg.o \
 	decoders/tga.o \
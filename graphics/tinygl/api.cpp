@@ -629,3 +629,26 @@ void tglSetShadowColor(unsigned char r, unsigned char g, unsigned char b) {
 	c->zb->shadow_color_g = g << 8;
 	c->zb->shadow_color_b = b << 8;
 }
+
+void tglSetShadowCaptureBuf(Common::Array<int> *buf) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	c->shadow_capture = buf;
+}
+
+void tglDrawShadowTriangles(const Common::Array<int> &buf) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	assert(c->zb->shadow_mask_buf);
+
+	// Same as gl_draw_triangle_fill() in shadow mode
+	TinyGL::ZBufferPoint p[3];
+	for (uint i = 0; i + 9 <= buf.size(); i += 9) {
+		for (int j = 0; j < 3; j++) {
+			p[j].x = buf[i + j * 3 + 0];
+			p[j].y = buf[i + j * 3 + 1];
+			p[j].z = buf[i + j * 3 + 2];
+		}
+		if (c->color_mask == 0)
+			TinyGL::ZB_fillTriangleDepthOnly(c->zb, &p[0], &p[1], &p[2]);
+		TinyGL::ZB_fillTriangleFlatShadow(c->zb, &p[0], &p[1], &p[2]);
+	}
+}
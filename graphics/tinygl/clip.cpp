@@ -396,6 +396,14 @@ void gl_draw_triangle_fill(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p
 		ZB_fillTriangleFlatShadowMask(c->zb, &p0->zp, &p1->zp, &p2->zp);
 	} else if (c->shadow_mode & 2) {
 		assert(c->zb->shadow_mask_buf);
+		if (c->shadow_capture) {
+			const ZBufferPoint *p[3] = { &p0->zp, &p1->zp, &p2->zp };
+			for (int i = 0; i < 3; i++) {
+				c->shadow_capture->push_back(p[i]->x);
+				c->shadow_capture->push_back(p[i]->y);
+				c->shadow_capture->push_back(p[i]->z);
+			}
+		}
 		ZB_fillTriangleFlatShadow(c->zb, &p0->zp, &p1->zp, &p2->zp);
 	} else if (c->texture_2d_enabled) {
 #ifdef TINYGL_PROFILE
@@ -4,6 +4,10 @@
 #ifndef GRAPHICS_TGL_H
 #define GRAPHICS_TGL_H
 
+namespace Common {
+template<class T> class Array;
+}
+
 #define TGL_VERSION_1_1 1
 
 enum {
@@ -794,6 +798,11 @@ void tglColorMask(TGLboolean r, TGLboolean g, TGLboolean b, TGLboolean a);
 
 void tglSetShadowMaskBuf(unsigned char *buf);
 void tglSetShadowColor(unsigned char r, unsigned char g, unsigned char b);
+// While buf is set, the triangles rasterized in shadow mode are appended to it,
+// as three (x, y, z) points in zbuffer coordinates. tglDrawShadowTriangles()
+// rasterizes them again, with the current shadow mask, color and color mask.
+void tglSetShadowCaptureBuf(Common::Array<int> *buf);
+void tglDrawShadowTriangles(const Common::Array<int> &buf);
 
 // opengl 1.2 arrays
 void tglEnableClientState(TGLenum array);
@@ -1,4 +1,6 @@
 
+#include "common/memorypool.h"
+
 #include "graphics/tinygl/zgl.h"
 
 namespace TinyGL {
@@ -10,6 +12,10 @@ void initSharedState(GLContext *c) {
 	s->lists = (GLList **)gl_zalloc(sizeof(GLList *) * MAX_DISPLAY_LISTS);
 	s->texture_hash_table = (GLTexture **)gl_zalloc(sizeof(GLTexture *) * TEXTURE_HASH_TABLE_SIZE);
 
+	s->list_pool = new Common::MemoryPool(sizeof(GLList));
+	s->op_buffer_pool = new Common::MemoryPool(sizeof(GLParamBuffer));
+	s->texture_pool = new Common::MemoryPool(sizeof(GLTexture));
+
 	alloc_texture(c, 0);
 }
 
@@ -24,6 +30,11 @@ void endSharedState(GLContext *c) {
 	gl_free(s->lists);
 
 	gl_free(s->texture_hash_table);
+
+	// Also releases the lists and textures which have not been deleted
+	delete s->list_pool;
+	delete s->op_buffer_pool;
+	delete s->texture_pool;
 }
 
 void glInit(void *zbuffer1) {
@@ -40,6 +51,8 @@ void glInit(void *zbuffer1) {
 	// allocate GLVertex array
 	c->vertex_max = POLYGON_MAX_VERTEX;
 	c->vertex = (GLVertex *)gl_malloc(POLYGON_MAX_VERTEX * sizeof(GLVertex));
+
+	gl_arena_init(&c->frame_arena, FRAME_ARENA_BLOCK_SIZE);
   
 	// viewport
 	v = &c->viewport;
@@ -169,6 +182,7 @@ void glInit(void *zbuffer1) {
 
 	// shadow mode
 	c->shadow_mode = 0;
+	c->shadow_capture = NULL;
 
 	// clear the resize callback function pointer
 	c->gl_resize_viewport = NULL;
@@ -192,6 +206,7 @@ void glClose() {
 		gl_free(c->matrix_stack[i]);
 	endSharedState(c);
 	gl_free(c->vertex);
+	gl_arena_free(&c->frame_arena);
 
 	gl_free(c);
 }
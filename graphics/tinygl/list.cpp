@@ -44,11 +44,11 @@ static void delete_list(GLContext *c, int list) {
 	pb = l->first_op_buffer;
 	while (pb) {
 		pb1 = pb->next;
-		gl_free(pb);
+		gl_pool_free(c->shared_state.op_buffer_pool, pb);
 		pb = pb1;
 	}
   
-	gl_free(l);
+	gl_pool_free(c->shared_state.list_pool, l);
 	c->shared_state.lists[list] = NULL;
 }
 
@@ -56,8 +56,8 @@ static GLList *alloc_list(GLContext *c, int list) {
 	GLList *l;
 	GLParamBuffer *ob;
 
-	l = (GLList *)gl_zalloc(sizeof(GLList));
-	ob = (GLParamBuffer *)gl_zalloc(sizeof(GLParamBuffer));
+	l = (GLList *)gl_pool_zalloc(c->shared_state.list_pool);
+	ob = (GLParamBuffer *)gl_pool_zalloc(c->shared_state.op_buffer_pool);
 
 	ob->next = NULL;
 	l->first_op_buffer = ob;
@@ -109,7 +109,7 @@ void gl_compile_op(GLContext *c, GLParam *p) {
 	// we should be able to add a NextBuffer opcode
 	if ((index + op_size) > (OP_BUFFER_MAX_SIZE - 2)) {
 
-		ob1 = (GLParamBuffer *)gl_zalloc(sizeof(GLParamBuffer));
+		ob1 = (GLParamBuffer *)gl_pool_zalloc(c->shared_state.op_buffer_pool);
 		ob1->next = NULL;
 
 		ob->next = ob1;
@@ -1,22 +1,126 @@
-
 // Memory allocator for TinyGL
 
+#include "common/memorypool.h"
+
 #include "graphics/tinygl/zgl.h"
 
 namespace TinyGL {
 
+static GLAllocStats alloc_stats;
+
 // modify these functions so that they suit your needs
 
 void gl_free(void *p) {
-    free(p);
+	alloc_stats.frees++;
+	free(p);
 }
 
 void *gl_malloc(int size) {
-    return malloc(size);
+	alloc_stats.mallocs++;
+	return malloc(size);
 }
 
 void *gl_zalloc(int size) {
-    return calloc(1, size);
+	alloc_stats.mallocs++;
+	return calloc(1, size);
+}
+
+GLAllocStats *gl_get_alloc_stats() {
+	return &alloc_stats;
+}
+
+void *gl_pool_zalloc(Common::MemoryPool *pool) {
+	void *p = pool->allocChunk();
+	memset(p, 0, pool->getChunkSize());
+	alloc_stats.pool_allocs++;
+	return p;
+}
+
+void gl_pool_free(Common::MemoryPool *pool, void *p) {
+	alloc_stats.pool_frees++;
+	pool->freeChunk(p);
+}
+
+// Alignment of the arena allocations
+#define ARENA_ALIGN 16
+
+struct GLArenaBlock {
+	GLArenaBlock *next;
+	int size;
+	int used;
+};
+
+// The data of the blocks starts after their header
+#define ARENA_HEADER_SIZE ((sizeof(GLArenaBlock) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+void gl_arena_init(GLArena *a, int block_size) {
+	a->first = a->current = a->last = NULL;
+	a->block_size = block_size;
+	a->used = 0;
+}
+
+void *gl_arena_alloc(GLArena *a, int size) {
+	size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+	// Blocks after the current one are only there when the arena has been reset
+	while (a->current && a->current->used + size > a->current->size)
+		a->current = a->current->next;
+
+	if (!a->current) {
+		int block_size = MAX(size, a->block_size);
+		GLArenaBlock *b = (GLArenaBlock *)malloc(ARENA_HEADER_SIZE + block_size);
+		b->next = NULL;
+		b->size = block_size;
+		b->used = 0;
+
+		if (a->last)
+			a->last->next = b;
+		else
+			a->first = b;
+		a->last = b;
+		a->current = b;
+
+		alloc_stats.arena_blocks++;
+	}
+
+	byte *p = (byte *)a->current + ARENA_HEADER_SIZE + a->current->used;
+	a->current->used += size;
+	a->used += size;
+
+	alloc_stats.arena_allocs++;
+	alloc_stats.arena_bytes += size;
+	return p;
+}
+
+void gl_arena_reset(GLArena *a) {
+	for (GLArenaBlock *b = a->first; b; b = b->next)
+		b->used = 0;
+
+	a->current = a->first;
+	alloc_stats.arena_bytes -= a->used;
+	a->used = 0;
+}
+
+void gl_arena_free(GLArena *a) {
+	gl_arena_reset(a);
+
+	GLArenaBlock *b = a->first;
+	while (b) {
+		GLArenaBlock *next = b->next;
+		free(b);
+		alloc_stats.arena_blocks--;
+		b = next;
+	}
+
+	a->first = a->current = a->last = NULL;
+}
+
+void *gl_frame_alloc(int size) {
+	return gl_arena_alloc(&gl_get_context()->frame_arena, size);
+}
+
+void gl_frame_reset() {
+	gl_arena_reset(&gl_get_context()->frame_arena);
 }
 
 } // end of namespace TinyGL
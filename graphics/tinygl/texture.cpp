@@ -38,13 +38,13 @@ void free_texture(GLContext *c, int h) {
 			im->pixmap.free();
 	}
 
-	gl_free(t);
+	gl_pool_free(c->shared_state.texture_pool, t);
 }
 
 GLTexture *alloc_texture(GLContext *c, int h) {
 	GLTexture *t, **ht;
 
-	t = (GLTexture *)gl_zalloc(sizeof(GLTexture));
+	t = (GLTexture *)gl_pool_zalloc(c->shared_state.texture_pool);
 
 	ht = &c->shared_state.texture_hash_table[h % TEXTURE_HASH_TABLE_SIZE];
 
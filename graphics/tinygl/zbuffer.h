@@ -3,6 +3,10 @@
 
 #include "graphics/pixelbuffer.h"
 
+namespace Common {
+class MemoryPool;
+}
+
 namespace TinyGL {
 
 // Z buffer
@@ -120,6 +124,39 @@ void gl_free(void *p);
 void *gl_malloc(int size);
 void *gl_zalloc(int size);
 
+// Fixed size objects, zeroed like gl_zalloc
+void *gl_pool_zalloc(Common::MemoryPool *pool);
+void gl_pool_free(Common::MemoryPool *pool, void *p);
+
+// Bump allocator: memory is taken from large blocks, and is only given
+// back all at once, to be reused (gl_arena_reset) or to the system.
+struct GLArenaBlock;
+
+struct GLArena {
+	GLArenaBlock *first;
+	GLArenaBlock *current;
+	GLArenaBlock *last;
+	int block_size;
+	int used;
+};
+
+void gl_arena_init(GLArena *a, int block_size);
+void *gl_arena_alloc(GLArena *a, int size);
+void gl_arena_reset(GLArena *a);
+void gl_arena_free(GLArena *a);
+
+struct GLAllocStats {
+	int mallocs;      // gl_malloc and gl_zalloc calls
+	int frees;        // gl_free calls
+	int pool_allocs;
+	int pool_frees;
+	int arena_allocs;
+	int arena_blocks; // blocks currently owned by the arenas
+	int arena_bytes;  // bytes currently allocated from the arenas
+};
+
+GLAllocStats *gl_get_alloc_stats();
+
 } // end of namespace TinyGL
 
 #endif
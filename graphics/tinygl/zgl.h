@@ -3,6 +3,7 @@
 
 #include "common/util.h"
 #include "common/textconsole.h"
+#include "common/array.h"
 
 #include "graphics/tinygl/gl.h"
 #include "graphics/tinygl/zbuffer.h"
@@ -41,6 +42,7 @@ enum {
 
 #define MAX_DISPLAY_LISTS 1024
 #define OP_BUFFER_MAX_SIZE 512
+#define FRAME_ARENA_BLOCK_SIZE (64 * 1024)
 
 #define TGL_OFFSET_FILL    0x1
 #define TGL_OFFSET_LINE    0x2
@@ -144,6 +146,11 @@ typedef struct GLTexture {
 typedef struct GLSharedState {
 	GLList **lists;
 	GLTexture **texture_hash_table;
+
+	// pools for the display lists and textures
+	Common::MemoryPool *list_pool;
+	Common::MemoryPool *op_buffer_pool;
+	Common::MemoryPool *texture_pool;
 } GLSharedState;
 
 struct GLContext;
@@ -177,6 +184,9 @@ typedef struct GLContext {
 	// shared state
 	GLSharedState shared_state;
 
+	// scratch memory, given back at each frame
+	GLArena frame_arena;
+
 	// current list
 	GLParamBuffer *current_op_buffer;
 	int current_op_buffer_index;
@@ -258,6 +268,7 @@ typedef struct GLContext {
 	int offset_states;
 
 	int shadow_mode;
+	Common::Array<int> *shadow_capture;
 
 	// specular buffer. could probably be shared between contexts,
 	// but that wouldn't be 100% thread safe
@@ -312,6 +323,10 @@ void gl_resizeImageNoInterpolate(unsigned char *dest, int xsize_dest, int ysize_
 
 GLContext *gl_get_context();
 
+// memory.c
+void *gl_frame_alloc(int size); // valid until the next gl_frame_reset()
+void gl_frame_reset();
+
 // specular buffer "api"
 GLSpecBuf *specbuf_get_buffer(GLContext *c, const int shininess_i, const float shininess);
 void specbuf_cleanup(GLContext *c); // free all memory used
@@ -0,0 +1,446 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include "common/endian.h"
+#include "common/simd.h"
+
+#include "graphics/yuv_to_rgb_simd.h"
+
+namespace Graphics {
+
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+
+// The lookup tables in YUVToRGBManager contain trunc(k * (c - 128)) for the
+// four chroma coefficients below. For every |c - 128| <= 128, this is exactly
+// (|c - 128| << kShift) * kMul >> 16 with the sign of (c - 128) reapplied.
+// Likewise, (x << 1) * 38155 >> 16 == x * 255 / 219 for every x in [0, 219],
+// which is the ITU-R BT.601 luminance scaling of YUVToRGBLookup.
+enum {
+	kCrRShift = 1, kCrRMul = 45876, // 0.419 / 0.299
+	kCrGShift = 0, kCrGMul = 46735, // 0.299 / 0.419
+	kCbGShift = 0, kCbGMul = 22562, // 0.114 / 0.331
+	kCbBShift = 1, kCbBMul = 58109, // 0.587 / 0.331
+	kITUMul = 38155
+};
+
+#if defined(SCUMMVM_SSE2)
+
+typedef __m128i Vec16;
+
+static FORCEINLINE Vec16 vSet(int16 x) { return _mm_set1_epi16(x); }
+static FORCEINLINE Vec16 vLoad(const int16 *src) { return _mm_loadu_si128((const __m128i *)src); }
+static FORCEINLINE Vec16 vAdd(Vec16 a, Vec16 b) { return _mm_add_epi16(a, b); }
+static FORCEINLINE Vec16 vSub(Vec16 a, Vec16 b) { return _mm_sub_epi16(a, b); }
+static FORCEINLINE Vec16 vMul(Vec16 a, Vec16 b) { return _mm_mullo_epi16(a, b); }
+static FORCEINLINE Vec16 vMin(Vec16 a, Vec16 b) { return _mm_min_epi16(a, b); }
+static FORCEINLINE Vec16 vMax(Vec16 a, Vec16 b) { return _mm_max_epi16(a, b); }
+static FORCEINLINE Vec16 vXor(Vec16 a, Vec16 b) { return _mm_xor_si128(a, b); }
+static FORCEINLINE Vec16 vSign(Vec16 a) { return _mm_srai_epi16(a, 15); }
+static FORCEINLINE Vec16 vShr4(Vec16 a) { return _mm_srli_epi16(a, 4); }
+template<int kShift>
+static FORCEINLINE Vec16 vShl(Vec16 a) { return _mm_slli_epi16(a, kShift); }
+static FORCEINLINE Vec16 vMulHiU(Vec16 a, uint16 m) { return _mm_mulhi_epu16(a, _mm_set1_epi16((int16)m)); }
+
+// Duplicate lanes 0-3 (resp. 4-7) into pairs
+static FORCEINLINE Vec16 vDupLo(Vec16 a) { return _mm_unpacklo_epi16(a, a); }
+static FORCEINLINE Vec16 vDupHi(Vec16 a) { return _mm_unpackhi_epi16(a, a); }
+
+// Repeat lanes 0-1 (resp. 2-3) four times each
+static FORCEINLINE Vec16 vQuadLo(Vec16 a) { Vec16 t = _mm_unpacklo_epi16(a, a); return _mm_unpacklo_epi32(t, t); }
+static FORCEINLINE Vec16 vQuadHi(Vec16 a) { Vec16 t = _mm_unpacklo_epi16(a, a); return _mm_unpackhi_epi32(t, t); }
+
+static FORCEINLINE Vec16 loadBytes8(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+static FORCEINLINE Vec16 loadBytes4(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(src)), _mm_setzero_si128());
+}
+
+struct PackParams {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+	bool itu;
+
+	PackParams(const PixelFormat &format, bool isITU) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		itu = isITU;
+	}
+};
+
+static FORCEINLINE __m128i packPixels16(Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p) {
+	__m128i pix = _mm_sll_epi16(_mm_srl_epi16(r, p.rLoss), p.rShift);
+	pix = _mm_or_si128(pix, _mm_sll_epi16(_mm_srl_epi16(g, p.gLoss), p.gShift));
+	pix = _mm_or_si128(pix, _mm_sll_epi16(_mm_srl_epi16(b, p.bLoss), p.bShift));
+	return _mm_or_si128(pix, _mm_sll_epi16(_mm_srl_epi16(a, p.aLoss), p.aShift));
+}
+
+static FORCEINLINE __m128i packPixels32(__m128i r, __m128i g, __m128i b, __m128i a, const PackParams &p) {
+	__m128i pix = _mm_sll_epi32(_mm_srl_epi32(r, p.rLoss), p.rShift);
+	pix = _mm_or_si128(pix, _mm_sll_epi32(_mm_srl_epi32(g, p.gLoss), p.gShift));
+	pix = _mm_or_si128(pix, _mm_sll_epi32(_mm_srl_epi32(b, p.bLoss), p.bShift));
+	return _mm_or_si128(pix, _mm_sll_epi32(_mm_srl_epi32(a, p.aLoss), p.aShift));
+}
+
+template<typename PixelInt>
+static FORCEINLINE void storePixels(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p);
+
+template<>
+FORCEINLINE void storePixels<uint16>(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p) {
+	_mm_storeu_si128((__m128i *)dst, packPixels16(r, g, b, a, p));
+}
+
+template<>
+FORCEINLINE void storePixels<uint32>(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p) {
+	const __m128i zero = _mm_setzero_si128();
+	_mm_storeu_si128((__m128i *)dst, packPixels32(_mm_unpacklo_epi16(r, zero), _mm_unpacklo_epi16(g, zero),
+	                                               _mm_unpacklo_epi16(b, zero), _mm_unpacklo_epi16(a, zero), p));
+	_mm_storeu_si128((__m128i *)(dst + 16), packPixels32(_mm_unpackhi_epi16(r, zero), _mm_unpackhi_epi16(g, zero),
+	                                                      _mm_unpackhi_epi16(b, zero), _mm_unpackhi_epi16(a, zero), p));
+}
+
+#elif defined(SCUMMVM_NEON)
+
+typedef int16x8_t Vec16;
+
+static FORCEINLINE Vec16 vSet(int16 x) { return vdupq_n_s16(x); }
+static FORCEINLINE Vec16 vLoad(const int16 *src) { return vld1q_s16(src); }
+static FORCEINLINE Vec16 vAdd(Vec16 a, Vec16 b) { return vaddq_s16(a, b); }
+static FORCEINLINE Vec16 vSub(Vec16 a, Vec16 b) { return vsubq_s16(a, b); }
+static FORCEINLINE Vec16 vMul(Vec16 a, Vec16 b) { return vmulq_s16(a, b); }
+static FORCEINLINE Vec16 vMin(Vec16 a, Vec16 b) { return vminq_s16(a, b); }
+static FORCEINLINE Vec16 vMax(Vec16 a, Vec16 b) { return vmaxq_s16(a, b); }
+static FORCEINLINE Vec16 vXor(Vec16 a, Vec16 b) { return veorq_s16(a, b); }
+static FORCEINLINE Vec16 vSign(Vec16 a) { return vshrq_n_s16(a, 15); }
+static FORCEINLINE Vec16 vShr4(Vec16 a) { return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(a), 4)); }
+template<int kShift>
+static FORCEINLINE Vec16 vShl(Vec16 a) { return vshlq_n_s16(a, kShift); }
+
+static FORCEINLINE Vec16 vMulHiU(Vec16 a, uint16 m) {
+	uint16x8_t ua = vreinterpretq_u16_s16(a);
+	uint32x4_t lo = vmull_u16(vget_low_u16(ua), vdup_n_u16(m));
+	uint32x4_t hi = vmull_u16(vget_high_u16(ua), vdup_n_u16(m));
+	return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16)));
+}
+
+static FORCEINLINE Vec16 vDupLo(Vec16 a) { return vzipq_s16(a, a).val[0]; }
+static FORCEINLINE Vec16 vDupHi(Vec16 a) { return vzipq_s16(a, a).val[1]; }
+
+static FORCEINLINE Vec16 vQuadLo(Vec16 a) {
+	int32x4_t t = vreinterpretq_s32_s16(vzipq_s16(a, a).val[0]);
+	return vreinterpretq_s16_s32(vzipq_s32(t, t).val[0]);
+}
+
+static FORCEINLINE Vec16 vQuadHi(Vec16 a) {
+	int32x4_t t = vreinterpretq_s32_s16(vzipq_s16(a, a).val[0]);
+	return vreinterpretq_s16_s32(vzipq_s32(t, t).val[1]);
+}
+
+static FORCEINLINE Vec16 loadBytes8(const byte *src) {
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src)));
+}
+
+static FORCEINLINE Vec16 loadBytes4(const byte *src) {
+	uint32x2_t v = vld1_lane_u32((const uint32 *)src, vdup_n_u32(0), 0);
+	return vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(v)));
+}
+
+struct PackParams {
+	// Right shifts are expressed as negative left shifts
+	int16x8_t rLoss16, gLoss16, bLoss16, aLoss16;
+	int16x8_t rShift16, gShift16, bShift16, aShift16;
+	int32x4_t rLoss32, gLoss32, bLoss32, aLoss32;
+	int32x4_t rShift32, gShift32, bShift32, aShift32;
+	bool itu;
+
+	PackParams(const PixelFormat &format, bool isITU) {
+		rLoss16 = vdupq_n_s16(-format.rLoss);
+		gLoss16 = vdupq_n_s16(-format.gLoss);
+		bLoss16 = vdupq_n_s16(-format.bLoss);
+		aLoss16 = vdupq_n_s16(-format.aLoss);
+		rShift16 = vdupq_n_s16(format.rShift);
+		gShift16 = vdupq_n_s16(format.gShift);
+		bShift16 = vdupq_n_s16(format.bShift);
+		aShift16 = vdupq_n_s16(format.aShift);
+		rLoss32 = vdupq_n_s32(-format.rLoss);
+		gLoss32 = vdupq_n_s32(-format.gLoss);
+		bLoss32 = vdupq_n_s32(-format.bLoss);
+		aLoss32 = vdupq_n_s32(-format.aLoss);
+		rShift32 = vdupq_n_s32(format.rShift);
+		gShift32 = vdupq_n_s32(format.gShift);
+		bShift32 = vdupq_n_s32(format.bShift);
+		aShift32 = vdupq_n_s32(format.aShift);
+		itu = isITU;
+	}
+};
+
+static FORCEINLINE uint16x8_t packChannel16(Vec16 c, int16x8_t loss, int16x8_t shift) {
+	return vshlq_u16(vshlq_u16(vreinterpretq_u16_s16(c), loss), shift);
+}
+
+static FORCEINLINE uint32x4_t packChannel32(uint16x4_t c, int32x4_t loss, int32x4_t shift) {
+	return vshlq_u32(vshlq_u32(vmovl_u16(c), loss), shift);
+}
+
+template<typename PixelInt>
+static FORCEINLINE void storePixels(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p);
+
+template<>
+FORCEINLINE void storePixels<uint16>(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p) {
+	uint16x8_t pix = packChannel16(r, p.rLoss16, p.rShift16);
+	pix = vorrq_u16(pix, packChannel16(g, p.gLoss16, p.gShift16));
+	pix = vorrq_u16(pix, packChannel16(b, p.bLoss16, p.bShift16));
+	pix = vorrq_u16(pix, packChannel16(a, p.aLoss16, p.aShift16));
+	vst1q_u8(dst, vreinterpretq_u8_u16(pix));
+}
+
+template<>
+FORCEINLINE void storePixels<uint32>(byte *dst, Vec16 r, Vec16 g, Vec16 b, Vec16 a, const PackParams &p) {
+	uint16x8_t ur = vreinterpretq_u16_s16(r), ug = vreinterpretq_u16_s16(g);
+	uint16x8_t ub = vreinterpretq_u16_s16(b), ua = vreinterpretq_u16_s16(a);
+
+	uint32x4_t lo = packChannel32(vget_low_u16(ur), p.rLoss32, p.rShift32);
+	lo = vorrq_u32(lo, packChannel32(vget_low_u16(ug), p.gLoss32, p.gShift32));
+	lo = vorrq_u32(lo, packChannel32(vget_low_u16(ub), p.bLoss32, p.bShift32));
+	lo = vorrq_u32(lo, packChannel32(vget_low_u16(ua), p.aLoss32, p.aShift32));
+	vst1q_u8(dst, vreinterpretq_u8_u32(lo));
+
+	uint32x4_t hi = packChannel32(vget_high_u16(ur), p.rLoss32, p.rShift32);
+	hi = vorrq_u32(hi, packChannel32(vget_high_u16(ug), p.gLoss32, p.gShift32));
+	hi = vorrq_u32(hi, packChannel32(vget_high_u16(ub), p.bLoss32, p.bShift32));
+	hi = vorrq_u32(hi, packChannel32(vget_high_u16(ua), p.aLoss32, p.aShift32));
+	vst1q_u8(dst + 16, vreinterpretq_u8_u32(hi));
+}
+
+#endif
+
+/** Per pixel offsets added to the luminance, as in the Cr_r/Cr_g+Cb_g/Cb_b tables */
+struct ChromaOffsets {
+	Vec16 r, g, b;
+};
+
+// trunc(k * c) for |c| <= 128, see the constants above
+template<int kShift, int kMul>
+static FORCEINLINE Vec16 mulChroma(Vec16 c) {
+	Vec16 sign = vSign(c);
+	Vec16 mag = vSub(vXor(c, sign), sign);
+	mag = vMulHiU(vShl<kShift>(mag), kMul);
+	return vSub(vXor(mag, sign), sign);
+}
+
+static FORCEINLINE ChromaOffsets computeChroma(Vec16 u, Vec16 v) {
+	const Vec16 zero = vSet(0);
+	Vec16 cr = vSub(v, vSet(128));
+	Vec16 cb = vSub(u, vSet(128));
+
+	ChromaOffsets c;
+	c.r = mulChroma<kCrRShift, kCrRMul>(cr);
+	c.g = vAdd(mulChroma<kCrGShift, kCrGMul>(vSub(zero, cr)), mulChroma<kCbGShift, kCbGMul>(vSub(zero, cb)));
+	c.b = mulChroma<kCbBShift, kCbBMul>(cb);
+	return c;
+}
+
+static FORCEINLINE ChromaOffsets dupChromaLo(const ChromaOffsets &c) {
+	ChromaOffsets d = { vDupLo(c.r), vDupLo(c.g), vDupLo(c.b) };
+	return d;
+}
+
+static FORCEINLINE ChromaOffsets dupChromaHi(const ChromaOffsets &c) {
+	ChromaOffsets d = { vDupHi(c.r), vDupHi(c.g), vDupHi(c.b) };
+	return d;
+}
+
+static FORCEINLINE Vec16 applyLuma(Vec16 y, Vec16 offset, bool itu) {
+	Vec16 x = vAdd(y, offset);
+	if (itu) {
+		x = vSub(vMin(vMax(x, vSet(16)), vSet(235)), vSet(16));
+		return vMulHiU(vShl<1>(x), kITUMul);
+	}
+	return vMin(vMax(x, vSet(0)), vSet(255));
+}
+
+template<typename PixelInt>
+static FORCEINLINE void putPixels(byte *dst, Vec16 y, Vec16 a, const ChromaOffsets &c, const PackParams &p) {
+	storePixels<PixelInt>(dst, applyLuma(y, c.r, p.itu), applyLuma(y, c.g, p.itu), applyLuma(y, c.b, p.itu), a, p);
+}
+
+static FORCEINLINE Vec16 loadAlpha(const byte *aSrc) {
+	return aSrc ? loadBytes8(aSrc) : vSet(0xFF);
+}
+
+template<typename PixelInt>
+static int convertYUV444(byte *dstPtr, int dstPitch, const PackParams &p, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	int width = yWidth & ~7;
+
+	for (int h = 0; h < yHeight; h++) {
+		for (int x = 0; x < width; x += 8) {
+			ChromaOffsets c = computeChroma(loadBytes8(uSrc + x), loadBytes8(vSrc + x));
+			putPixels<PixelInt>(dstPtr + x * sizeof(PixelInt), loadBytes8(ySrc + x), loadAlpha(aSrc ? aSrc + x : 0), c, p);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+		if (aSrc)
+			aSrc += yPitch;
+	}
+
+	return width;
+}
+
+template<typename PixelInt>
+static int convertYUV420(byte *dstPtr, int dstPitch, const PackParams &p, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	int width = yWidth & ~15;
+	int halfHeight = yHeight >> 1;
+
+	for (int h = 0; h < halfHeight; h++) {
+		for (int x = 0; x < width; x += 16) {
+			ChromaOffsets c = computeChroma(loadBytes8(uSrc + (x >> 1)), loadBytes8(vSrc + (x >> 1)));
+			ChromaOffsets lo = dupChromaLo(c);
+			ChromaOffsets hi = dupChromaHi(c);
+			byte *dst = dstPtr + x * sizeof(PixelInt);
+			const byte *y = ySrc + x;
+			const byte *a = aSrc ? aSrc + x : 0;
+
+			putPixels<PixelInt>(dst, loadBytes8(y), loadAlpha(a), lo, p);
+			putPixels<PixelInt>(dst + 8 * sizeof(PixelInt), loadBytes8(y + 8), loadAlpha(a ? a + 8 : 0), hi, p);
+			putPixels<PixelInt>(dst + dstPitch, loadBytes8(y + yPitch), loadAlpha(a ? a + yPitch : 0), lo, p);
+			putPixels<PixelInt>(dst + dstPitch + 8 * sizeof(PixelInt), loadBytes8(y + yPitch + 8), loadAlpha(a ? a + yPitch + 8 : 0), hi, p);
+		}
+
+		dstPtr += dstPitch << 1;
+		ySrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+		if (aSrc)
+			aSrc += yPitch << 1;
+	}
+
+	return width;
+}
+
+// Bilinear interpolation of the chroma quads, matching DO_INTERPOLATION
+static FORCEINLINE Vec16 interpolate410(Vec16 a, Vec16 b, Vec16 c, Vec16 d, const Vec16 *weights) {
+	Vec16 sum = vAdd(vMul(a, weights[0]), vMul(b, weights[1]));
+	sum = vAdd(sum, vAdd(vMul(c, weights[2]), vMul(d, weights[3])));
+	return vShr4(sum);
+}
+
+template<typename PixelInt>
+static int convertYUV410(byte *dstPtr, int dstPitch, const PackParams &p, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	// Four chroma samples, so 16 pixels, per iteration
+	int quarterWidth = (yWidth >> 2) & ~3;
+
+	for (int y = 0; y < yHeight; y++) {
+		int targetY = y >> 2;
+		int yDiff = y & 3;
+
+		Vec16 weights[4];
+		int16 w[4][8];
+		for (int i = 0; i < 8; i++) {
+			int xDiff = i & 3;
+			w[0][i] = (4 - xDiff) * (4 - yDiff);
+			w[1][i] = xDiff * (4 - yDiff);
+			w[2][i] = yDiff * (4 - xDiff);
+			w[3][i] = xDiff * yDiff;
+		}
+		for (int i = 0; i < 4; i++)
+			weights[i] = vLoad(w[i]);
+
+		for (int x = 0; x < quarterWidth; x += 4) {
+			int index = targetY * uvPitch + x;
+
+			Vec16 uA = loadBytes4(uSrc + index), uB = loadBytes4(uSrc + index + 1);
+			Vec16 uC = loadBytes4(uSrc + index + uvPitch), uD = loadBytes4(uSrc + index + uvPitch + 1);
+			Vec16 vA = loadBytes4(vSrc + index), vB = loadBytes4(vSrc + index + 1);
+			Vec16 vC = loadBytes4(vSrc + index + uvPitch), vD = loadBytes4(vSrc + index + uvPitch + 1);
+
+			ChromaOffsets lo = computeChroma(
+				interpolate410(vQuadLo(uA), vQuadLo(uB), vQuadLo(uC), vQuadLo(uD), weights),
+				interpolate410(vQuadLo(vA), vQuadLo(vB), vQuadLo(vC), vQuadLo(vD), weights));
+			ChromaOffsets hi = computeChroma(
+				interpolate410(vQuadHi(uA), vQuadHi(uB), vQuadHi(uC), vQuadHi(uD), weights),
+				interpolate410(vQuadHi(vA), vQuadHi(vB), vQuadHi(vC), vQuadHi(vD), weights));
+
+			int column = x << 2;
+			byte *dst = dstPtr + column * sizeof(PixelInt);
+			const byte *a = aSrc ? aSrc + column : 0;
+
+			putPixels<PixelInt>(dst, loadBytes8(ySrc + column), loadAlpha(a), lo, p);
+			putPixels<PixelInt>(dst + 8 * sizeof(PixelInt), loadBytes8(ySrc + column + 8), loadAlpha(a ? a + 8 : 0), hi, p);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		if (aSrc)
+			aSrc += yPitch;
+	}
+
+	return quarterWidth << 2;
+}
+
+#define CONVERT_SIMD(func) \
+	PackParams p(format, itu); \
+	if (format.bytesPerPixel == 2) \
+		return func<uint16>(dstPtr, dstPitch, p, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch); \
+	else \
+		return func<uint32>(dstPtr, dstPitch, p, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch)
+
+int convertYUV444ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	CONVERT_SIMD(convertYUV444);
+}
+
+int convertYUV420ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	CONVERT_SIMD(convertYUV420);
+}
+
+int convertYUV410ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	CONVERT_SIMD(convertYUV410);
+}
+
+#undef CONVERT_SIMD
+
+#else
+
+int convertYUV444ToRGBSIMD(byte *, int, const PixelFormat &, bool, const byte *, const byte *, const byte *, const byte *, int, int, int, int) {
+	return 0;
+}
+
+int convertYUV420ToRGBSIMD(byte *, int, const PixelFormat &, bool, const byte *, const byte *, const byte *, const byte *, int, int, int, int) {
+	return 0;
+}
+
+int convertYUV410ToRGBSIMD(byte *, int, const PixelFormat &, bool, const byte *, const byte *, const byte *, const byte *, int, int, int, int) {
+	return 0;
+}
+
+#endif
+
+} // End of namespace Graphics
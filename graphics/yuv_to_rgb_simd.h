@@ -0,0 +1,68 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/**
+ * @file
+ * Vectorized YUV to RGB(A) converters shared by YUVToRGBManager and
+ * YUVAToRGBAManager.
+ *
+ * The converters produce exactly the same pixels as the lookup table code:
+ * the chroma tables and the ITU luminance scale are evaluated with fixed
+ * point multiplies that have been checked to match them for every input.
+ * They only handle as many whole vectors as fit in a row and return the
+ * number of columns they converted; the caller converts the remaining
+ * columns with the table code.
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_SIMD_H
+#define GRAPHICS_YUV_TO_RGB_SIMD_H
+
+#include "common/scummsys.h"
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * Convert the left part of a YUV444 image.
+ *
+ * @param aSrc  the alpha plane, with the same pitch as the y plane, or 0
+ *              to produce opaque pixels
+ * @param itu   whether the luminance uses the ITU-R BT.601 [16, 235] range
+ * @return the number of columns converted, 0 if no vectorized path is available
+ */
+int convertYUV444ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
+/**
+ * Convert the left part of a YUV420 image. See convertYUV444ToRGBSIMD().
+ * The number of converted columns is always even.
+ */
+int convertYUV420ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
+/**
+ * Convert the left part of a YUV410 image. See convertYUV444ToRGBSIMD().
+ * The number of converted columns is always a multiple of 4.
+ */
+int convertYUV410ToRGBSIMD(byte *dstPtr, int dstPitch, const PixelFormat &format, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+
+} // End of namespace Graphics
+
+#endif
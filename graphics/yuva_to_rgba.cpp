@@ -83,8 +83,11 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/simd.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuva_to_rgba.h"
+#include "graphics/yuv_to_rgb_simd.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVAToRGBAManager);
@@ -238,7 +241,7 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVAToRGBALookup *lo
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		aSrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
@@ -254,13 +257,27 @@ void YUVAToRGBAManager::convert420(Graphics::Surface *dst, YUVAToRGBAManager::Lu
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
+	// Convert as much as possible with the vector code, and let the
+	// lookup tables handle the remaining columns
+	int simdWidth = 0;
+	if (Common::hasSIMD())
+		simdWidth = convertYUV420ToRGBSIMD((byte *)dst->getPixels(), dst->pitch, dst->format, scale == kScaleITU, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+
+	if (simdWidth == yWidth)
+		return;
+
 	const YUVAToRGBALookup *lookup = getLookup(dst->format, scale);
+	byte *dstPtr = (byte *)dst->getBasePtr(simdWidth, 0);
+	ySrc += simdWidth;
+	uSrc += simdWidth >> 1;
+	vSrc += simdWidth >> 1;
+	aSrc += simdWidth;
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint16>(dstPtr, dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth - simdWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint32>(dstPtr, dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth - simdWidth, yHeight, yPitch, uvPitch);
 }
 
 } // End of namespace Graphics
@@ -51,6 +51,10 @@ const int kMaxRecordsNames = 0x64;
 const int kDefaultScreenshotPeriod = 60000;
 const int kDefaultBPP = 2;
 
+static const char *const kBenchmarkSectionNames[kBenchmarkSectionCount] = {
+	"scripts", "actors", "render", "audio"
+};
+
 uint32 readTime(Common::ReadStream *inFile) {
 	uint32 d = inFile->readByte();
 	if (d == 0xff) {
@@ -90,6 +94,18 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = 0;
 
+	_benchmark = false;
+	_benchmarkReport = 0;
+	_benchmarkFrames = 0;
+	_benchmarkSection = -1;
+	_benchmarkPresentSection = -1;
+	_benchmarkSectionStart = 0;
+	_benchmarkFrameStart = 0;
+	_benchmarkFrameMax = 0;
+	_benchmarkTotal = 0;
+	memset(_benchmarkTimes, 0, sizeof(_benchmarkTimes));
+	memset(_benchmarkTotalTimes, 0, sizeof(_benchmarkTotalTimes));
+
 	DebugMan.addDebugChannel(kDebugLevelEventRec, "EventRec", "Event recorder debug level");
 }
 
@@ -104,6 +120,10 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	if (_benchmark) {
+		writeBenchmarkSummary();
+		_benchmark = false;
+	}
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -262,7 +282,21 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
+void EventRecorder::init(Common::String recordFileName, RecordMode mode, bool benchmark) {
+	if (benchmark && mode == kRecorderPlayback) {
+		// Opened before switching to the fake save manager
+		_benchmarkReport = g_system->getSavefileManager()->openForSaving(recordFileName + ".bench", false);
+		if (!_benchmarkReport)
+			error("playback:action=error reason=\"Benchmark report creation error\"");
+		_benchmark = true;
+		_fastPlayback = true;
+		_benchmarkFrames = 0;
+		_benchmarkSection = -1;
+		_benchmarkFrameMax = 0;
+		_benchmarkTotal = 0;
+		memset(_benchmarkTimes, 0, sizeof(_benchmarkTimes));
+		memset(_benchmarkTotalTimes, 0, sizeof(_benchmarkTotalTimes));
+	}
 	_fakeMixerManager = new NullSdlMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -302,8 +336,9 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 
 	switchMixer();
 	switchTimerManagers();
-	_needRedraw = true;
+	_needRedraw = !_benchmark;
 	_initialized = true;
+	_benchmarkFrameStart = getBenchmarkMicros();
 }
 
 
@@ -431,7 +466,9 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
+	int previous = enterBenchmarkSection(kBenchmarkAudio);
 	_fakeMixerManager->update();
+	leaveBenchmarkSection(previous);
 	_recordMode = oldRecordMode;
 }
 
@@ -558,6 +595,12 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		// The control panel is not drawn, but presenting the frame counts
+		// as rendering time.
+		_benchmarkPresentSection = enterBenchmarkSection(kBenchmarkRender);
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -572,6 +615,11 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		leaveBenchmarkSection(_benchmarkPresentSection);
+		finishBenchmarkFrame();
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -665,6 +713,91 @@ bool EventRecorder::checkForContinueGame() {
 	return result;
 }
 
+uint64 EventRecorder::getBenchmarkMicros() {
+	// g_system->getMillis() returns the recorded time during playback
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return SDL_GetPerformanceCounter() * 1000000 / SDL_GetPerformanceFrequency();
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+int EventRecorder::enterBenchmarkSection(BenchmarkSection section) {
+	if (!_benchmark) {
+		return -1;
+	}
+	uint64 now = getBenchmarkMicros();
+	int previous = _benchmarkSection;
+	if (previous >= 0) {
+		_benchmarkTimes[previous] += now - _benchmarkSectionStart;
+	}
+	_benchmarkSection = section;
+	_benchmarkSectionStart = now;
+	return previous;
+}
+
+void EventRecorder::leaveBenchmarkSection(int previous) {
+	if (!_benchmark || _benchmarkSection < 0) {
+		return;
+	}
+	uint64 now = getBenchmarkMicros();
+	_benchmarkTimes[_benchmarkSection] += now - _benchmarkSectionStart;
+	_benchmarkSection = previous;
+	_benchmarkSectionStart = now;
+}
+
+void EventRecorder::finishBenchmarkFrame() {
+	uint64 now = getBenchmarkMicros();
+	uint64 frameTime = now - _benchmarkFrameStart;
+	_benchmarkFrameStart = now;
+
+	Common::String line = Common::String::format("frame=%u time=%u millis=%u", _benchmarkFrames, (uint32)frameTime, _fakeTimer);
+	for (int i = 0; i < kBenchmarkSectionCount; ++i) {
+		line += Common::String::format(" %s=%u", kBenchmarkSectionNames[i], (uint32)_benchmarkTimes[i]);
+		_benchmarkTotalTimes[i] += _benchmarkTimes[i];
+		_benchmarkTimes[i] = 0;
+	}
+	_benchmarkReport->writeString(line + "\n");
+
+	_benchmarkTotal += frameTime;
+	_benchmarkFrameMax = MAX(_benchmarkFrameMax, frameTime);
+	_benchmarkFrames++;
+}
+
+void EventRecorder::benchmarkCheckpoint(const uint8 md5[16], bool match) {
+	if (!_benchmark) {
+		return;
+	}
+	Common::String line = Common::String::format("checkpoint frame=%u millis=%u md5=", _benchmarkFrames, _fakeTimer);
+	for (int i = 0; i < 16; ++i) {
+		line += Common::String::format("%02x", md5[i]);
+	}
+	line += match ? " result=success\n" : " result=fail\n";
+	_benchmarkReport->writeString(line);
+}
+
+void EventRecorder::writeBenchmarkSummary() {
+	uint32 frames = MAX<uint32>(_benchmarkFrames, 1);
+	Common::String line = Common::String::format("summary frames=%u time=%u average=%u max=%u", _benchmarkFrames,
+	                                             (uint32)_benchmarkTotal, (uint32)(_benchmarkTotal / frames), (uint32)_benchmarkFrameMax);
+	for (int i = 0; i < kBenchmarkSectionCount; ++i) {
+		line += Common::String::format(" %s=%u", kBenchmarkSectionNames[i], (uint32)(_benchmarkTotalTimes[i] / frames));
+	}
+	_benchmarkReport->writeString(line + "\n");
+	_benchmarkReport->finalize();
+	delete _benchmarkReport;
+	_benchmarkReport = 0;
+	debugC(1, kDebugLevelEventRec, "playback:action=benchmark frames=%u average=%u", _benchmarkFrames, (uint32)(_benchmarkTotal / frames));
+}
+
+BenchmarkScope::BenchmarkScope(BenchmarkSection section) {
+	_previous = g_eventRec.enterBenchmarkSection(section);
+}
+
+BenchmarkScope::~BenchmarkScope() {
+	g_eventRec.leaveBenchmarkSection(_previous);
+}
+
 void EventRecorder::deleteTemporarySave() {
 	if (_temporarySlot == -1) return;
 	const Common::String gameId = ConfMan.get("gameid");
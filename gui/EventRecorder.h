@@ -31,6 +31,37 @@
 
 #include "engines/advancedDetector.h"
 
+namespace GUI {
+
+/** The parts of a frame timed separately when benchmarking a recording */
+enum BenchmarkSection {
+	kBenchmarkScripts = 0,
+	kBenchmarkActors,
+	kBenchmarkRender,
+	kBenchmarkAudio,
+	kBenchmarkSectionCount
+};
+
+/**
+ * Adds the time spent in the enclosing block to a section of the current
+ * frame, when a recording is played back in benchmark mode. The time spent
+ * in nested scopes only counts for the innermost one.
+ */
+class BenchmarkScope {
+public:
+#ifdef ENABLE_EVENTRECORDER
+	BenchmarkScope(BenchmarkSection section);
+	~BenchmarkScope();
+
+private:
+	int _previous;
+#else
+	BenchmarkScope(BenchmarkSection section) {}
+#endif
+};
+
+} // End of namespace GUI
+
 #ifdef ENABLE_EVENTRECORDER
 
 #include "common/mutex.h"
@@ -78,7 +109,13 @@ public:
 		kRecorderPlaybackPause = 3	/**< kRecordetPlaybackPause, interal state when user pauses the playback */
 	};
 
-	void init(Common::String recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back events.
+	 *
+	 * @param benchmark	play back as fast as possible, without the control
+	 *			panel, and write the frame timings to a report
+	 */
+	void init(Common::String recordFileName, RecordMode mode, bool benchmark = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -175,6 +212,11 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/** Benchmark hooks, see BenchmarkScope */
+	int enterBenchmarkSection(BenchmarkSection section);
+	void leaveBenchmarkSection(int previous);
+	void benchmarkCheckpoint(const uint8 md5[16], bool match);
+
 private:
 	virtual Common::List<Common::Event> mapEvent(const Common::Event &ev, Common::EventSource *source);
 	bool notifyPoll();
@@ -229,6 +271,22 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	bool _benchmark;
+	Common::WriteStream *_benchmarkReport;
+	uint32 _benchmarkFrames;
+	int _benchmarkSection;
+	int _benchmarkPresentSection;
+	uint64 _benchmarkSectionStart;
+	uint64 _benchmarkFrameStart;
+	uint64 _benchmarkFrameMax;
+	uint64 _benchmarkTotal;
+	uint64 _benchmarkTimes[kBenchmarkSectionCount];
+	uint64 _benchmarkTotalTimes[kBenchmarkSectionCount];
+
+	uint64 getBenchmarkMicros();
+	void finishBenchmarkFrame();
+	void writeBenchmarkSummary();
 };
 
 } // End of namespace GUI
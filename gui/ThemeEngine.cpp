@@ -83,6 +83,9 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the result of the draw steps only depends on their area
+	    and on the background, so that it can be cached */
+	bool _cacheable;
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -92,6 +95,13 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Checks whether the draw steps can be cached. The renderer keeps the
+	 * colors of the previous drawing when a step does not set them, and
+	 * some steps draw outside of the widget area.
+	 */
+	void calcCacheable();
 };
 
 class ThemeItem {
@@ -232,11 +242,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawWidgetLayer(_data, _area, extendedRect, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -274,7 +281,7 @@ void ThemeItemBitmap::drawSelf(bool draw, bool restore) {
  *********************************************************/
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
-	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
+	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled), _layerCacheSize(0), _layerCacheClock(0),
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(0) {
 
@@ -320,6 +327,8 @@ ThemeEngine::~ThemeEngine() {
 	_screen.free();
 	_backBuffer.free();
 
+	clearLayerCache();
+
 	unloadTheme();
 
 	// Release all graphics surfaces
@@ -519,6 +528,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	clearLayerCache();
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -544,11 +555,135 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_backgroundOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	_cacheable = true;
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		if (!step->fgColor.set || !step->bgColor.set)
+			_cacheable = false;
+
+		if (step->fillMode == Graphics::VectorRenderer::kFillGradient && !(step->gradColor1.set && step->gradColor2.set))
+			_cacheable = false;
+
+		if (step->bevel && !step->bevelColor.set)
+			_cacheable = false;
+
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+			_cacheable = false;
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
 }
 
+static void copySurfaceArea(Graphics::Surface &dst, int dstX, int dstY, const Graphics::Surface &src, const Common::Rect &r) {
+	const int rowSize = r.width() * src.format.bytesPerPixel;
+
+	for (int y = 0; y < r.height(); ++y)
+		memcpy(dst.getBasePtr(dstX, dstY + y), src.getBasePtr(r.left, r.top + y), rowSize);
+}
+
+static bool surfaceAreaEquals(const Graphics::Surface &a, const Graphics::Surface &b, const Common::Rect &r) {
+	// a holds the pixels of the area r of b
+	const int rowSize = r.width() * b.format.bytesPerPixel;
+
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(a.getBasePtr(0, y), b.getBasePtr(r.left, r.top + y), rowSize))
+			return false;
+	}
+
+	return true;
+}
+
+void ThemeEngine::drawWidgetLayer(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamic) {
+	Graphics::Surface *target = _vectorRenderer->getActiveSurface();
+
+	Common::Rect r = extendedArea;
+	r.clip(target->w, target->h);
+
+	if (!data->_cacheable || r.isEmpty()) {
+		Common::List<Graphics::DrawStep>::const_iterator step;
+		for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->drawStep(area, *step, dynamic);
+		return;
+	}
+
+	LayerCacheKey key;
+	key.data = data;
+	key.area = area;
+	key.dynamic = dynamic;
+	key.shadows = _vectorRenderer->shadowsEnabled();
+
+	CachedLayer *cached = _layerCache.getVal(key, 0);
+	if (cached && cached->area == r && surfaceAreaEquals(cached->background, *target, r)) {
+		cached->lastUse = ++_layerCacheClock;
+		copySurfaceArea(*target, r.left, r.top, cached->layer, Common::Rect(r.width(), r.height()));
+		return;
+	}
+
+	if (!cached) {
+		uint32 size = 2 * r.width() * r.height() * target->format.bytesPerPixel;
+		if (size > kLayerMaxSize) {
+			Common::List<Graphics::DrawStep>::const_iterator step;
+			for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+				_vectorRenderer->drawStep(area, *step, dynamic);
+			return;
+		}
+
+		while (_layerCacheSize + size > kLayerCacheMaxSize)
+			evictLayer();
+
+		cached = new CachedLayer();
+		cached->background.create(r.width(), r.height(), target->format);
+		cached->layer.create(r.width(), r.height(), target->format);
+		cached->size = size;
+		_layerCache[key] = cached;
+		_layerCacheSize += size;
+	}
+
+	cached->area = r;
+	cached->lastUse = ++_layerCacheClock;
+	copySurfaceArea(cached->background, 0, 0, *target, r);
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+		_vectorRenderer->drawStep(area, *step, dynamic);
+
+	copySurfaceArea(cached->layer, 0, 0, *target, r);
+}
+
+void ThemeEngine::evictLayer() {
+	// Drop the least recently drawn layer
+	LayerCache::iterator oldest = _layerCache.end();
+	for (LayerCache::iterator i = _layerCache.begin(); i != _layerCache.end(); ++i) {
+		if (oldest == _layerCache.end() || i->_value->lastUse < oldest->_value->lastUse)
+			oldest = i;
+	}
+
+	assert(oldest != _layerCache.end());
+
+	CachedLayer *cached = oldest->_value;
+	_layerCacheSize -= cached->size;
+	_layerCache.erase(oldest);
+
+	cached->background.free();
+	cached->layer.free();
+	delete cached;
+}
+
+void ThemeEngine::clearLayerCache() {
+	for (LayerCache::iterator i = _layerCache.begin(); i != _layerCache.end(); ++i) {
+		i->_value->background.free();
+		i->_value->layer.free();
+		delete i->_value;
+	}
+
+	_layerCache.clear();
+	_layerCacheSize = 0;
+}
+
 
 
 /**********************************************************
@@ -673,6 +808,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_buffer = kDrawDataDefaults[id].buffer;
+	_widgets[id]->_cacheable = false;
 	_widgets[id]->_textDataId = kTextDataNone;
 
 	return true;
@@ -704,11 +840,14 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 }
 
 void ThemeEngine::unloadTheme() {
+	clearLayerCache();
+
 	if (!_themeOk)
 		return;
 
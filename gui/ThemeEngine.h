@@ -523,6 +523,20 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws the steps of a DrawData item on the active drawing surface.
+	 *
+	 * Steps blend with what is below them, so the result is cached along
+	 * with the background it was drawn over. Drawing the same item at the
+	 * same place over the same background again only blits the cached layer.
+	 *
+	 * @param data DrawData item to draw.
+	 * @param area Area of the widget.
+	 * @param extendedArea Area the steps may draw to, e.g. including shadows.
+	 * @param dynamic Dynamic data of the draw steps.
+	 */
+	void drawWidgetLayer(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedArea, uint32 dynamic);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -538,6 +552,9 @@ protected:
 	 */
 	template<typename PixelType> void screenInit(bool backBuffer = true);
 
+	/** Frees all the cached widget layers. */
+	void clearLayerCache();
+
 	/**
 	 * Loads the given theme into the ThemeEngine.
 	 *
@@ -673,6 +690,48 @@ protected:
 	/** Queue with all the drawing that must be done to the screen */
 	Common::List<ThemeItem *> _screenQueue;
 
+	/** A widget drawn at a given place, with a given state */
+	struct LayerCacheKey {
+		const WidgetDrawData *data;
+		Common::Rect area;
+		uint32 dynamic;
+		bool shadows;
+
+		bool operator==(const LayerCacheKey &other) const {
+			return data == other.data && area == other.area && dynamic == other.dynamic && shadows == other.shadows;
+		}
+	};
+
+	struct LayerCacheKey_Hash {
+		uint operator()(const LayerCacheKey &key) const {
+			return (uint)(size_t)key.data ^ (key.area.left << 20) ^ (key.area.top << 10)
+				^ (key.area.width() << 5) ^ key.area.height() ^ (key.dynamic * 31) ^ key.shadows;
+		}
+	};
+
+	/** Pixels of a drawn widget, and of the background they were drawn over */
+	struct CachedLayer {
+		Common::Rect area;
+		Graphics::Surface background;
+		Graphics::Surface layer;
+		uint32 size;    ///< Memory used by both surfaces, in bytes
+		uint32 lastUse; ///< Value of _layerCacheClock when last drawn
+	};
+
+	typedef Common::HashMap<LayerCacheKey, CachedLayer *, LayerCacheKey_Hash> LayerCache;
+
+	/** Maximum memory used by the cached widget layers, in bytes */
+	static const uint32 kLayerCacheMaxSize = 4 * 1024 * 1024;
+
+	/** Layers bigger than this are not cached, so that a few of them can't take the whole cache */
+	static const uint32 kLayerMaxSize = kLayerCacheMaxSize / 8;
+
+	void evictLayer();
+
+	LayerCache _layerCache;
+	uint32 _layerCacheSize;
+	uint32 _layerCacheClock;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
@@ -24,6 +24,8 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/debug-channels.h"
+#include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #include "engines/engine.h"
@@ -64,6 +66,9 @@ Debugger::Debugger() {
 	DCmd_Register("debugflag_list",		WRAP_METHOD(Debugger, Cmd_DebugFlagsList));
 	DCmd_Register("debugflag_enable",	WRAP_METHOD(Debugger, Cmd_DebugFlagEnable));
 	DCmd_Register("debugflag_disable",	WRAP_METHOD(Debugger, Cmd_DebugFlagDisable));
+#ifdef ENABLE_ZONE_PROFILER
+	DCmd_Register("profile",			WRAP_METHOD(Debugger, Cmd_Profile));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -537,6 +542,47 @@ bool Debugger::Cmd_DebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef ENABLE_ZONE_PROFILER
+bool Debugger::Cmd_Profile(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc < 2) {
+		Common::Array<Common::Profiler::ZoneStats> stats;
+		profiler.getStats(stats);
+
+		DebugPrintf("Profiler %s, %d zones entered:\n", profiler.isEnabled() ? "enabled" : "disabled", stats.size());
+		for (uint i = 0; i < stats.size(); i++)
+			DebugPrintf("%s\n", Common::Profiler::formatStats(stats[i]).c_str());
+		DebugPrintf("Usage: profile [on|off|clear|overlay <on|off>|export <file>]\n");
+	} else if (!strcmp(argv[1], "on") || !strcmp(argv[1], "off")) {
+		profiler.setEnabled(!strcmp(argv[1], "on"));
+		DebugPrintf("Profiler %s\n", profiler.isEnabled() ? "enabled" : "disabled");
+	} else if (!strcmp(argv[1], "clear")) {
+		profiler.clear();
+		DebugPrintf("Profiler data cleared\n");
+	} else if (!strcmp(argv[1], "overlay") && argc > 2) {
+		if (!showProfilerOverlay(!strcmp(argv[2], "on")))
+			DebugPrintf("The profiler overlay is not supported by this engine\n");
+	} else if (!strcmp(argv[1], "export") && argc > 2) {
+		Common::DumpFile file;
+		if (!file.open(argv[2])) {
+			DebugPrintf("Failed to open '%s'\n", argv[2]);
+			return true;
+		}
+
+		uint events = profiler.exportTrace(file);
+		file.finalize();
+		if (file.err())
+			DebugPrintf("Failed to write '%s'\n", argv[2]);
+		else
+			DebugPrintf("Exported %d events to '%s'\n", events, argv[2]);
+	} else {
+		DebugPrintf("Usage: profile [on|off|clear|overlay <on|off>|export <file>]\n");
+	}
+	return true;
+}
+#endif
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -175,6 +175,14 @@ protected:
 	 */
 	void detach();
 
+	/**
+	 * Hook for subclasses to show or hide the statistics of the profiling
+	 * zones over the game, for the "profile overlay" command.
+	 *
+	 * The default implementation returns false, for not supported.
+	 */
+	virtual bool showProfilerOverlay(bool show) { return false; }
+
 private:
 	void enter();
 
@@ -195,6 +203,9 @@ protected:
 	bool Cmd_DebugFlagsList(int argc, const char **argv);
 	bool Cmd_DebugFlagEnable(int argc, const char **argv);
 	bool Cmd_DebugFlagDisable(int argc, const char **argv);
+#ifdef ENABLE_ZONE_PROFILER
+	bool Cmd_Profile(int argc, const char **argv);
+#endif
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "common/simd.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Convert one second of a full scale sine into an output buffer which
+	// already holds some samples, so that the additions saturate.
+	int16 *convertSine(const int inRate, const int outRate, const bool isStereo, const bool reverseStereo,
+	                   const Audio::RateConverterQuality quality, const bool useSIMD, int &len) {
+		Audio::SeekableAudioStream *s = createSineStream<int16>(inRate, 1, 0, false, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo, quality);
+
+		const int outLen = outRate + 64;
+		int16 *buffer = new int16[outLen * 2];
+		for (int i = 0; i < outLen * 2; ++i)
+			buffer[i] = (int16)((i * 7919) % 65536 - 32768);
+
+		Common::setSIMDEnabled(useSIMD);
+		len = 0;
+		int step = 1;
+		while (len < outLen) {
+			// Use odd request sizes, to exercise the partial blocks
+			const int n = converter->flow(*s, buffer + len * 2, MIN(step, outLen - len), 200, 129);
+			if (n == 0)
+				break;
+			len += n;
+			step = step * 3 + 1;
+		}
+		Common::setSIMDEnabled(true);
+
+		delete converter;
+		delete s;
+		return buffer;
+	}
+
+	void compareSIMDTemplate(const int inRate, const int outRate, const bool isStereo, const bool reverseStereo,
+	                         const Audio::RateConverterQuality quality) {
+		int scalarLen, simdLen;
+		int16 *scalar = convertSine(inRate, outRate, isStereo, reverseStereo, quality, false, scalarLen);
+		int16 *simd = convertSine(inRate, outRate, isStereo, reverseStereo, quality, true, simdLen);
+
+		TS_ASSERT_EQUALS(scalarLen, simdLen);
+		TS_ASSERT_EQUALS(memcmp(scalar, simd, (outRate + 64) * 2 * sizeof(int16)), 0);
+
+		delete[] scalar;
+		delete[] simd;
+	}
+
+	void dcTemplate(const int inRate, const int outRate, const bool isStereo, const Audio::RateConverterQuality quality) {
+		const int samples = inRate * (isStereo ? 2 : 1);
+		int16 *data = (int16 *)malloc(samples * sizeof(int16));
+		for (int i = 0; i < samples; ++i)
+			WRITE_LE_UINT16(&data[i], (i & 1) && isStereo ? -1234 : 5678);
+
+		Audio::SeekableAudioStream *s = Audio::makeRawStream((const byte *)data, samples * sizeof(int16), inRate,
+		                                Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (isStereo ? Audio::FLAG_STEREO : 0));
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, false, quality);
+
+		int16 *buffer = new int16[outRate * 4];
+		memset(buffer, 0, outRate * 4 * sizeof(int16));
+		const int len = converter->flow(*s, buffer, outRate * 2, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+		// The filter drops the last half window of the input
+		TS_ASSERT_LESS_THAN_EQUALS(outRate - 32 * outRate / inRate, len);
+		TS_ASSERT_LESS_THAN_EQUALS(len, outRate);
+
+		// Skip the fade in from the initial silence
+		for (int i = 64; i < len; ++i) {
+			TS_ASSERT_EQUALS(buffer[i * 2 + 0], 5678);
+			TS_ASSERT_EQUALS(buffer[i * 2 + 1], isStereo ? -1234 : 5678);
+		}
+
+		delete[] buffer;
+		delete converter;
+		delete s;
+	}
+
+public:
+	void test_copy_simd_mono() {
+		compareSIMDTemplate(22050, 22050, false, false, Audio::kRateConverterLinear);
+	}
+
+	void test_copy_simd_stereo() {
+		compareSIMDTemplate(22050, 22050, true, false, Audio::kRateConverterLinear);
+		compareSIMDTemplate(22050, 22050, true, true, Audio::kRateConverterLinear);
+	}
+
+	void test_simple_simd() {
+		compareSIMDTemplate(44100, 22050, false, false, Audio::kRateConverterLinear);
+		compareSIMDTemplate(44100, 22050, true, true, Audio::kRateConverterLinear);
+	}
+
+	void test_linear_simd() {
+		compareSIMDTemplate(11025, 22050, false, false, Audio::kRateConverterLinear);
+		compareSIMDTemplate(22050, 48000, true, false, Audio::kRateConverterLinear);
+		compareSIMDTemplate(22050, 48000, true, true, Audio::kRateConverterLinear);
+	}
+
+	void test_sinc_simd() {
+		compareSIMDTemplate(11025, 22050, false, false, Audio::kRateConverterSinc);
+		compareSIMDTemplate(22050, 48000, true, true, Audio::kRateConverterSinc);
+		compareSIMDTemplate(48000, 22050, true, false, Audio::kRateConverterSincBest);
+	}
+
+	void test_sinc_dc() {
+		dcTemplate(11025, 22050, false, Audio::kRateConverterSinc);
+		dcTemplate(22050, 44100, true, Audio::kRateConverterSinc);
+		dcTemplate(44100, 22050, true, Audio::kRateConverterSincBest);
+		dcTemplate(22050, 48000, false, Audio::kRateConverterSincBest);
+	}
+};
@@ -3,8 +3,60 @@
 #include "common/bitstream.h"
 #include "common/memstream.h"
 
+#include "helper.h"
+
 class BitStreamTestSuite : public CxxTest::TestSuite
 {
+	// Check that a memory bit stream reads the same as the stream based
+	// one with the same layout, with random reads, peeks and skips.
+	template<class MEMORYSTREAM, class BITSTREAM>
+	static void compareMemoryStream() {
+		byte contents[203];
+		TestRandom rnd(3);
+		for (uint32 i = 0; i < sizeof(contents); i++)
+			contents[i] = rnd.next() >> 16;
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		BITSTREAM bs(ms);
+		MEMORYSTREAM mbs(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(mbs.size(), bs.size());
+		TS_ASSERT_EQUALS(mbs.isMSBFirst(), bs.isMSBFirst());
+
+		while (true) {
+			uint32 seed = rnd.next();
+			uint32 n = (seed >> 16) % 33;
+			if (bs.pos() + n > bs.size())
+				break;
+
+			switch ((seed >> 8) % 4) {
+			case 0:
+				TS_ASSERT_EQUALS(mbs.peekBits(n), bs.peekBits(n));
+				// fall through
+			case 1:
+				TS_ASSERT_EQUALS(mbs.getBits(n), bs.getBits(n));
+				break;
+			case 2:
+				TS_ASSERT_EQUALS(mbs.getBit(), bs.getBit());
+				break;
+			default:
+				// Also skip further than the cached bits
+				if (n == 32 && bs.pos() + 100 <= bs.size())
+					n = 100;
+				bs.skip(n);
+				mbs.skip(n);
+				break;
+			}
+
+			TS_ASSERT_EQUALS(mbs.pos(), bs.pos());
+		}
+
+		TS_ASSERT_EQUALS(mbs.eos(), bs.eos());
+		mbs.rewind();
+		bs.rewind();
+		TS_ASSERT_EQUALS(mbs.getBits(32), bs.getBits(32));
+	}
+
 	public:
 	void test_get_bit() {
 		byte contents[] = { 'a' };
@@ -149,4 +201,31 @@ class BitStreamTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(bs.peekBits(5), 12u);
 		TS_ASSERT(!bs.eos());
 	}
+
+	void test_memory_eos() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::BitStreamMemory8MSB bs(contents, sizeof(contents));
+		bs.skip(11);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT_EQUALS(bs.getBits(5), 2u);
+		TS_ASSERT(bs.eos());
+
+		bs.rewind();
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		TS_ASSERT(!bs.eos());
+	}
+
+	void test_memory_layouts() {
+		compareMemoryStream<Common::BitStreamMemory8MSB, Common::BitStream8MSB>();
+		compareMemoryStream<Common::BitStreamMemory8LSB, Common::BitStream8LSB>();
+		compareMemoryStream<Common::BitStreamMemory16LEMSB, Common::BitStream16LEMSB>();
+		compareMemoryStream<Common::BitStreamMemory16LELSB, Common::BitStream16LELSB>();
+		compareMemoryStream<Common::BitStreamMemory16BEMSB, Common::BitStream16BEMSB>();
+		compareMemoryStream<Common::BitStreamMemory16BELSB, Common::BitStream16BELSB>();
+		compareMemoryStream<Common::BitStreamMemory32LEMSB, Common::BitStream32LEMSB>();
+		compareMemoryStream<Common::BitStreamMemory32LELSB, Common::BitStream32LELSB>();
+		compareMemoryStream<Common::BitStreamMemory32BEMSB, Common::BitStream32BEMSB>();
+		compareMemoryStream<Common::BitStreamMemory32BELSB, Common::BitStream32BELSB>();
+	}
 };
@@ -0,0 +1,146 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/dct.h"
+#include "common/fft.h"
+#include "common/rdft.h"
+#include "common/simd.h"
+
+#include "helper.h"
+
+/**
+ * Checks the transforms against a plain DFT, and the vectorized
+ * butterflies against the scalar code.
+ */
+class FFTTestSuite : public CxxTest::TestSuite {
+	static void fillRandom(float *data, int count, uint32 seed) {
+		TestRandom rnd(seed);
+		for (int i = 0; i < count; i++)
+			data[i] = (int)((rnd.next() >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+	}
+
+	static bool nearlyEqual(const float *a, const float *b, int count, float tolerance) {
+		for (int i = 0; i < count; i++) {
+			float diff = a[i] - b[i];
+			if (diff < -tolerance || diff > tolerance)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void fft(int bits, int inverse, bool useSIMD, float *data) {
+		Common::FFT fft(bits, inverse);
+
+		Common::setSIMDEnabled(useSIMD);
+		fft.permute((Common::Complex *)data);
+		fft.calc((Common::Complex *)data);
+		Common::setSIMDEnabled(true);
+	}
+
+	static void rdft(int bits, Common::RDFT::TransformType trans, bool useSIMD, float *data) {
+		Common::RDFT rdft(bits, trans);
+
+		Common::setSIMDEnabled(useSIMD);
+		rdft.calc(data);
+		Common::setSIMDEnabled(true);
+	}
+
+	static void dct(int bits, Common::DCT::TransformType trans, bool useSIMD, float *data) {
+		Common::DCT dct(bits, trans);
+
+		Common::setSIMDEnabled(useSIMD);
+		dct.calc(data);
+		Common::setSIMDEnabled(true);
+	}
+
+	public:
+	void test_fft_dft() {
+		const int n = 64;
+		float input[2 * n], output[2 * n];
+		fillRandom(input, 2 * n, 1);
+
+		for (int inverse = 0; inverse < 2; inverse++) {
+			memcpy(output, input, sizeof(input));
+			fft(6, inverse, true, output);
+
+			for (int k = 0; k < n; k++) {
+				double re = 0.0, im = 0.0;
+				for (int j = 0; j < n; j++) {
+					double angle = (inverse ? 2.0 : -2.0) * M_PI * j * k / n;
+					re += input[2 * j] * cos(angle) - input[2 * j + 1] * sin(angle);
+					im += input[2 * j] * sin(angle) + input[2 * j + 1] * cos(angle);
+				}
+
+				TS_ASSERT_DELTA(output[2 * k], re, 1e-3);
+				TS_ASSERT_DELTA(output[2 * k + 1], im, 1e-3);
+			}
+		}
+	}
+
+	void test_fft_simd() {
+		static float scalar[2 << 12], simd[2 << 12];
+
+		for (int bits = 2; bits <= 12; bits++) {
+			for (int inverse = 0; inverse < 2; inverse++) {
+				const int count = 2 << bits;
+				fillRandom(scalar, count, bits);
+				memcpy(simd, scalar, count * sizeof(float));
+
+				fft(bits, inverse, false, scalar);
+				fft(bits, inverse, true, simd);
+
+				TS_ASSERT(nearlyEqual(scalar, simd, count, 1e-4f));
+			}
+		}
+	}
+
+	void test_rdft_simd() {
+		static float scalar[1 << 12], simd[1 << 12];
+
+		for (int bits = 4; bits <= 12; bits++) {
+			for (int trans = 0; trans < 4; trans++) {
+				const int count = 1 << bits;
+				fillRandom(scalar, count, bits + trans);
+				memcpy(simd, scalar, count * sizeof(float));
+
+				rdft(bits, (Common::RDFT::TransformType)trans, false, scalar);
+				rdft(bits, (Common::RDFT::TransformType)trans, true, simd);
+
+				TS_ASSERT(nearlyEqual(scalar, simd, count, 1e-4f));
+			}
+		}
+	}
+
+	void test_dct_simd() {
+		static float scalar[(1 << 11) + 1], simd[(1 << 11) + 1];
+
+		for (int bits = 4; bits <= 11; bits++) {
+			for (int trans = 0; trans < 4; trans++) {
+				// DCT-I uses n + 1 values
+				const int count = (1 << bits) + 1;
+				fillRandom(scalar, count, bits * trans);
+				memcpy(simd, scalar, count * sizeof(float));
+
+				dct(bits, (Common::DCT::TransformType)trans, false, scalar);
+				dct(bits, (Common::DCT::TransformType)trans, true, simd);
+
+				TS_ASSERT(nearlyEqual(scalar, simd, count, 1e-3f));
+			}
+		}
+	}
+
+	void test_batched() {
+		static float single[2][1 << 9], batched[2][1 << 9];
+		float *buffers[2] = { batched[0], batched[1] };
+
+		fillRandom(single[0], 2 << 9, 5);
+		memcpy(batched, single, sizeof(single));
+
+		Common::RDFT rdft(9, Common::RDFT::DFT_C2R);
+		rdft.calc(single[0]);
+		rdft.calc(single[1]);
+		rdft.calc(buffers, 2);
+
+		TS_ASSERT_EQUALS(memcmp(single, batched, sizeof(single)), 0);
+	}
+};
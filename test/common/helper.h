@@ -0,0 +1,25 @@
+#ifndef TEST_COMMON_HELPER_H
+#define TEST_COMMON_HELPER_H
+
+#include "common/scummsys.h"
+
+/**
+ * Repeatable pseudo random numbers for test data.
+ *
+ * Common::RandomSource needs a backend to seed it, so the tests use
+ * this plain linear congruential generator instead.
+ */
+class TestRandom {
+	uint32 _seed;
+
+public:
+	TestRandom(uint32 seed) : _seed(seed) {}
+
+	/** Return the next state, whose low bits are the least random. */
+	uint32 next() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed;
+	}
+};
+
+#endif
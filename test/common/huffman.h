@@ -3,6 +3,8 @@
 #include "common/bitstream.h"
 #include "common/memstream.h"
 
+#include "helper.h"
+
 /**
 * A test suite for the Huffman decoder in common/huffman.h
 * The encoding used comes from the example on the Wikipedia page
@@ -10,6 +12,68 @@
 * TODO: It could be improved by generating one at runtime.
 */
 class HuffmanTestSuite : public CxxTest::TestSuite {
+	// A complete code with the lengths 1 to 13 and two codes of 14 bits,
+	// so that the longest ones need a second level table.
+	static const uint32 kLongCodeCount = 15;
+
+	static void makeLongCodes(uint32 *codes, uint8 *lengths, bool msbFirst) {
+		uint32 code = 0;
+		for (uint32 i = 0; i < kLongCodeCount; i++) {
+			lengths[i] = MIN<uint32>(i + 1, 14);
+			if (i > 0)
+				code = (code + 1) << (lengths[i] - lengths[i - 1]);
+
+			// The codes of LSB to MSB streams start with their lowest bit
+			codes[i] = 0;
+			for (uint32 j = 0; j < lengths[i]; j++)
+				codes[i] |= ((code >> j) & 1) << (msbFirst ? j : lengths[i] - 1 - j);
+		}
+	}
+
+	// Write the codes of random symbols, returning the number of bits written
+	static uint32 encode(byte *data, uint32 dataSize, uint32 *symbols, uint32 symbolCount,
+	                     const uint32 *codes, const uint8 *lengths, bool msbFirst) {
+		memset(data, 0, dataSize);
+
+		TestRandom rnd(1);
+		uint32 bitPos = 0;
+		for (uint32 i = 0; i < symbolCount; i++) {
+			symbols[i] = (rnd.next() >> 16) % kLongCodeCount;
+
+			for (uint32 j = 0; j < lengths[symbols[i]]; j++, bitPos++) {
+				uint32 shift = msbFirst ? lengths[symbols[i]] - 1 - j : j;
+				uint32 bit = (codes[symbols[i]] >> shift) & 1;
+				data[bitPos / 8] |= bit << (msbFirst ? 7 - bitPos % 8 : bitPos % 8);
+			}
+		}
+
+		assert(bitPos <= dataSize * 8);
+		return bitPos;
+	}
+
+	template<class BITSTREAM>
+	static void decodeLongCodes() {
+		uint32 codes[kLongCodeCount];
+		uint8 lengths[kLongCodeCount];
+
+		// Filled in by encode(), once the bit order of the stream is known
+		byte data[1024] = { 0 };
+		uint32 symbols[300];
+
+		Common::MemoryReadStream ms(data, sizeof(data));
+		BITSTREAM bs(ms);
+		const bool msbFirst = bs.isMSBFirst();
+
+		makeLongCodes(codes, lengths, msbFirst);
+		Common::Huffman h(0, kLongCodeCount, codes, lengths);
+
+		uint32 bitCount = encode(data, sizeof(data), symbols, ARRAYSIZE(symbols), codes, lengths, msbFirst);
+
+		for (uint32 i = 0; i < ARRAYSIZE(symbols); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), symbols[i]);
+		TS_ASSERT_EQUALS(bs.pos(), bitCount);
+	}
+
 	public:
 	void test_get_with_full_symbols() {
 
@@ -141,4 +205,78 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_long_codes() {
+		decodeLongCodes<Common::BitStream8MSB>();
+		decodeLongCodes<Common::BitStream8LSB>();
+	}
+
+	void test_end_of_stream() {
+		// The last codes are shorter than the table index
+		const uint8 lengths[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10};
+		const uint32 codes[]  = {0x0, 0x2, 0x6, 0xE, 0x1E, 0x3E, 0x7E, 0xFE, 0x1FE, 0x3FE, 0x3FF};
+
+		Common::Huffman h(0, ARRAYSIZE(codes), codes, lengths);
+
+		// 111111110 0 10 110 0 = symbols 8, 0, 1, 2, 0
+		byte input[] = {0xFF, 0x2C};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8MSB bs(ms);
+
+		TS_ASSERT_EQUALS(h.getSymbol(bs), 8u);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), 0u);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), 1u);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), 2u);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), 0u);
+		TS_ASSERT(bs.eos());
+	}
+
+	/**
+	 * Decode the symbols with the table decoder, and again with the
+	 * previous decoder, which added one bit at a time to the code and
+	 * compared it with all the codes of that length.
+	 */
+	template<class BITSTREAM>
+	static void decodeAgainstReference(BITSTREAM &bs, const Common::Huffman &h, const uint32 *codes, const uint8 *lengths,
+	                                   const uint32 *symbols, uint32 symbolCount, uint32 bitCount) {
+		for (uint32 i = 0; i < symbolCount; i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), symbols[i]);
+		TS_ASSERT_EQUALS(bs.pos(), bitCount);
+
+		bs.rewind();
+
+		for (uint32 i = 0; i < symbolCount; i++) {
+			uint32 code = 0;
+			uint32 symbol = kLongCodeCount;
+			for (uint32 length = 1; symbol == kLongCodeCount; length++) {
+				bs.addBit(code, length - 1);
+
+				for (uint32 j = 0; j < kLongCodeCount; j++) {
+					if (lengths[j] == length && codes[j] == code)
+						symbol = j;
+				}
+			}
+			TS_ASSERT_EQUALS(symbol, symbols[i]);
+		}
+		TS_ASSERT_EQUALS(bs.pos(), bitCount);
+	}
+
+	void test_decode_reference() {
+		uint32 codes[kLongCodeCount];
+		uint8 lengths[kLongCodeCount];
+		makeLongCodes(codes, lengths, true);
+		Common::Huffman h(0, kLongCodeCount, codes, lengths);
+
+		static byte data[64 * 1024];
+		static uint32 symbols[40000];
+		uint32 bitCount = encode(data, sizeof(data), symbols, ARRAYSIZE(symbols), codes, lengths, true);
+
+		Common::MemoryReadStream ms(data, sizeof(data));
+		Common::BitStream8MSB bs(ms);
+		decodeAgainstReference(bs, h, codes, lengths, symbols, ARRAYSIZE(symbols), bitCount);
+
+		Common::BitStreamMemory8MSB mbs(data, sizeof(data));
+		decodeAgainstReference(mbs, h, codes, lengths, symbols, ARRAYSIZE(symbols), bitCount);
+	}
 };
@@ -0,0 +1,94 @@
+// <pthread.h> pulls in time.h
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+
+#include "thread_system.h"
+
+#ifdef POSIX
+
+#include <pthread.h>
+
+namespace {
+
+struct Thread {
+	pthread_t thread;
+	OSystem::ThreadProc proc;
+	void *param;
+};
+
+void *threadEntry(void *thread) {
+	((Thread *)thread)->proc(((Thread *)thread)->param);
+	return 0;
+}
+
+} // End of anonymous namespace
+
+OSystem::MutexRef ThreadTestSystem::createMutex() {
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+	pthread_mutex_t *mutex = new pthread_mutex_t;
+	pthread_mutex_init(mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	return (MutexRef)mutex;
+}
+
+void ThreadTestSystem::lockMutex(MutexRef mutex) {
+	pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+void ThreadTestSystem::unlockMutex(MutexRef mutex) {
+	pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+void ThreadTestSystem::deleteMutex(MutexRef mutex) {
+	pthread_mutex_destroy((pthread_mutex_t *)mutex);
+	delete (pthread_mutex_t *)mutex;
+}
+
+OSystem::ThreadRef ThreadTestSystem::createThread(ThreadProc proc, void *param) {
+	if (!threadsEnabled)
+		return 0;
+
+	Thread *thread = new Thread();
+	thread->proc = proc;
+	thread->param = param;
+	if (pthread_create(&thread->thread, 0, threadEntry, thread)) {
+		delete thread;
+		return 0;
+	}
+	return (ThreadRef)thread;
+}
+
+void ThreadTestSystem::joinThread(ThreadRef thread) {
+	pthread_join(((Thread *)thread)->thread, 0);
+	delete (Thread *)thread;
+}
+
+OSystem::ConditionRef ThreadTestSystem::createCondition() {
+	if (!threadsEnabled)
+		return 0;
+
+	pthread_cond_t *cond = new pthread_cond_t;
+	pthread_cond_init(cond, 0);
+	return (ConditionRef)cond;
+}
+
+void ThreadTestSystem::waitCondition(ConditionRef cond, MutexRef mutex) {
+	pthread_cond_wait((pthread_cond_t *)cond, (pthread_mutex_t *)mutex);
+}
+
+void ThreadTestSystem::signalCondition(ConditionRef cond) {
+	pthread_cond_signal((pthread_cond_t *)cond);
+}
+
+void ThreadTestSystem::broadcastCondition(ConditionRef cond) {
+	pthread_cond_broadcast((pthread_cond_t *)cond);
+}
+
+void ThreadTestSystem::deleteCondition(ConditionRef cond) {
+	pthread_cond_destroy((pthread_cond_t *)cond);
+	delete (pthread_cond_t *)cond;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef TEST_COMMON_THREAD_SYSTEM_H
+#define TEST_COMMON_THREAD_SYSTEM_H
+
+#include "common/system.h"
+#include "graphics/pixelbuffer.h"
+
+/**
+ * Just enough of a backend for the thread pool: recursive mutexes,
+ * and threads and conditions when the platform has pthreads and
+ * threadsEnabled is set.
+ */
+class ThreadTestSystem : public OSystem {
+public:
+	bool threadsEnabled;
+
+	ThreadTestSystem() : threadsEnabled(true) {}
+
+	virtual void initBackend() {}
+	virtual bool hasFeature(Feature f) { return false; }
+	virtual void setFeatureState(Feature f, bool enable) {}
+	virtual bool getFeatureState(Feature f) { return false; }
+	virtual const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+	virtual int getDefaultGraphicsMode() const { return 0; }
+	virtual bool setGraphicsMode(int mode) { return false; }
+	virtual int getGraphicsMode() const { return 0; }
+	virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	virtual void launcherInitSize(uint width, uint height) {}
+	virtual Graphics::PixelBuffer setupScreen(int screenW, int screenH, bool fullscreen, bool accel3d) { return Graphics::PixelBuffer(); }
+	virtual int16 getHeight() { return 0; }
+	virtual int16 getWidth() { return 0; }
+	virtual PaletteManager *getPaletteManager() { return 0; }
+	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual Graphics::Surface *lockScreen() { return 0; }
+	virtual void unlockScreen() {}
+	virtual void fillScreen(uint32 col) {}
+	virtual void updateScreen() {}
+	virtual void setShakePos(int shakeOffset) {}
+	virtual void showOverlay() {}
+	virtual void hideOverlay() {}
+	virtual Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat(); }
+	virtual void clearOverlay() {}
+	virtual void grabOverlay(void *buf, int pitch) {}
+	virtual void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual int16 getOverlayHeight() { return 0; }
+	virtual int16 getOverlayWidth() { return 0; }
+	virtual bool showMouse(bool visible) { return false; }
+	virtual bool lockMouse(bool lock) { return false; }
+	virtual void warpMouse(int x, int y) {}
+	virtual void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	virtual uint32 getMillis(bool skipRecord) { return 0; }
+	virtual void delayMillis(uint msecs) {}
+	virtual void getTimeAndDate(TimeDate &t) const {}
+	virtual Common::TimerManager *getTimerManager() { return 0; }
+	virtual Common::EventManager *getEventManager() { return 0; }
+	virtual Audio::Mixer *getMixer() { return 0; }
+	virtual void quit() {}
+	virtual void displayMessageOnOSD(const char *msg) {}
+	virtual Common::SaveFileManager *getSavefileManager() { return 0; }
+	virtual FilesystemFactory *getFilesystemFactory() { return 0; }
+	virtual void logMessage(LogMessageType::Type type, const char *message) {}
+
+#ifdef POSIX
+	// In thread_system.cpp, which can include <pthread.h>
+	virtual MutexRef createMutex();
+	virtual void lockMutex(MutexRef mutex);
+	virtual void unlockMutex(MutexRef mutex);
+	virtual void deleteMutex(MutexRef mutex);
+
+	virtual ThreadRef createThread(ThreadProc proc, void *param);
+	virtual void joinThread(ThreadRef thread);
+
+	virtual ConditionRef createCondition();
+	virtual void waitCondition(ConditionRef cond, MutexRef mutex);
+	virtual void signalCondition(ConditionRef cond);
+	virtual void broadcastCondition(ConditionRef cond);
+	virtual void deleteCondition(ConditionRef cond);
+#else
+	// Without threads, the mutexes have nothing to protect
+	virtual MutexRef createMutex() { return (MutexRef)1; }
+	virtual void lockMutex(MutexRef mutex) {}
+	virtual void unlockMutex(MutexRef mutex) {}
+	virtual void deleteMutex(MutexRef mutex) {}
+#endif
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+#include "thread_system.h"
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+	static const uint kJobCount = 200;
+
+	struct Job {
+		uint runs;
+		bool done;
+	};
+
+	// Each job only writes to its own entry, some work first so
+	// that waitForJobs() has to wait for the running ones
+	static void runJob(void *data) {
+		Job *job = (Job *)data;
+		job->runs++;
+
+		volatile uint32 work = 0;
+		for (uint i = 0; i < 20000; i++)
+			work = work * 31 + i;
+
+		job->done = true;
+	}
+
+	static void checkJobs(uint workers, bool threadsEnabled) {
+		ThreadTestSystem system;
+		system.threadsEnabled = threadsEnabled;
+		OSystem *previous = g_system;
+		g_system = &system;
+
+		Job jobs[kJobCount];
+		memset(jobs, 0, sizeof(jobs));
+
+		{
+			Common::ThreadPool pool(workers);
+
+			// Several batches, to reuse the workers after waiting
+			for (uint batch = 0; batch < 4; batch++) {
+				for (uint i = batch; i < kJobCount; i += 4)
+					pool.addJob(runJob, &jobs[i]);
+
+				pool.waitForJobs();
+				TS_ASSERT(!pool.hasPendingJobs());
+				for (uint i = batch; i < kJobCount; i += 4)
+					TS_ASSERT(jobs[i].done);
+			}
+		}
+
+		for (uint i = 0; i < kJobCount; i++)
+			TS_ASSERT_EQUALS(jobs[i].runs, 1u);
+
+		g_system = previous;
+	}
+
+	public:
+	void test_inline_jobs() {
+		ThreadTestSystem system;
+		OSystem *previous = g_system;
+		g_system = &system;
+
+		{
+			Common::ThreadPool pool(0);
+			TS_ASSERT_EQUALS(pool.getNumWorkers(), 0u);
+
+			// Run right away, on the calling thread
+			Job job = { 0, false };
+			pool.addJob(runJob, &job);
+			TS_ASSERT(job.done);
+			TS_ASSERT_EQUALS(job.runs, 1u);
+			TS_ASSERT(!pool.hasPendingJobs());
+		}
+
+		g_system = previous;
+	}
+
+	void test_no_thread_support() {
+		// The pool falls back to running the jobs inline
+		checkJobs(3, false);
+	}
+
+#ifdef POSIX
+	void test_worker_jobs() {
+		checkJobs(1, true);
+		checkJobs(4, true);
+	}
+#endif
+};
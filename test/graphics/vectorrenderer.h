@@ -0,0 +1,157 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/simd.h"
+#include "graphics/surface.h"
+#include "graphics/VectorRendererSpec.h"
+#include "graphics/VectorRendererSpecSIMD.h"
+
+#include "test/common/helper.h"
+
+/**
+ * Checks that the vectorized row kernels of the vector renderer give the
+ * same pixels as the scalar code, whatever the format and the widths.
+ */
+class VectorRendererTestSuite : public CxxTest::TestSuite {
+	static void fillSurface(Graphics::Surface &surface, uint32 seed) {
+		TestRandom rnd(seed);
+		byte *pixels = (byte *)surface.getPixels();
+		for (int i = 0; i < surface.h * surface.pitch; i++)
+			pixels[i] = (rnd.next() >> 16) & 0xFF;
+	}
+
+	// Draw the shapes using fills, blended fills, gradients and shadows
+	static void drawShapes(Graphics::VectorRenderer *renderer) {
+		renderer->setFgColor(200, 40, 90);
+		renderer->setBgColor(10, 220, 140);
+		renderer->setGradientColors(255, 255, 255, 30, 60, 250);
+
+		for (int i = 0; i < 3; i++) {
+			renderer->setFillMode((Graphics::VectorRenderer::FillMode)(Graphics::VectorRenderer::kFillBackground + i));
+			renderer->setShadowOffset(i * 3);
+			renderer->setStrokeWidth(i + 1);
+			renderer->setGradientFactor(i + 1);
+
+			renderer->drawSquare(3 + i, 5 + i * 50, 97 + i * 13, 33 + i);
+			renderer->drawRoundedSquare(130 + i, 7 + i * 50, 4 + i * 3, 61 + i * 7, 40);
+			renderer->drawCircle(250, 30 + i * 50, 12 + i);
+			renderer->drawLine(0, 190 - i, 299, 150 + i);
+		}
+	}
+
+	static bool compare(const Graphics::PixelFormat &format, int width, int height) {
+		Graphics::Surface scalar, simd;
+		scalar.create(width, height, format);
+		simd.create(width, height, format);
+		fillSurface(scalar, 1);
+		fillSurface(simd, 1);
+
+		Graphics::VectorRenderer *renderer;
+		if (format.bytesPerPixel == 4)
+			renderer = new Graphics::VectorRendererSpec<uint32>(format);
+		else
+			renderer = new Graphics::VectorRendererSpec<uint16>(format);
+
+		Common::setSIMDEnabled(false);
+		renderer->setSurface(&scalar);
+		drawShapes(renderer);
+		Common::setSIMDEnabled(true);
+		renderer->setSurface(&simd);
+		drawShapes(renderer);
+
+		bool equal = memcmp(scalar.getPixels(), simd.getPixels(), height * scalar.pitch) == 0;
+
+		delete renderer;
+		scalar.free();
+		simd.free();
+		return equal;
+	}
+
+	template<typename PixelType>
+	static void compareBlend(const Graphics::PixelFormat &format) {
+		// Reference from VectorRendererSpec::blendPixelPtr()
+		const uint32 masks[3] = {
+			(uint32)(0xFF >> format.rLoss) << format.rShift,
+			(uint32)(0xFF >> format.gLoss) << format.gShift,
+			(uint32)(0xFF >> format.bLoss) << format.bShift
+		};
+		const uint32 alphaMask = (uint32)(0xFF >> format.aLoss) << format.aShift;
+
+		PixelType pixels[37], expected[37];
+		TestRandom rnd(7);
+		for (int alpha = 0; alpha < 256; alpha += 5) {
+			PixelType color = (PixelType)(rnd.next() >> 8);
+
+			for (int i = 0; i < 37; i++) {
+				pixels[i] = (PixelType)(rnd.next() >> 4);
+
+				uint32 out = pixels[i] & alphaMask;
+				for (int c = 0; c < 3; c++) {
+					int64 dst = pixels[i] & masks[c];
+					int64 src = color & masks[c];
+					out |= masks[c] & (uint32)(dst + (((src - dst) * alpha) >> 8));
+				}
+				expected[i] = (PixelType)out;
+			}
+
+			int done = Graphics::blendFillSIMD(pixels, 37, color, alpha, format);
+			for (int i = 0; i < done; i++)
+				TS_ASSERT_EQUALS(pixels[i], expected[i]);
+		}
+	}
+
+	template<typename PixelType>
+	static void compareDarken(PixelType keepMask, PixelType orBits, PixelType addBits) {
+		PixelType pixels[21], expected[21];
+		for (int i = 0; i < 21; i++) {
+			pixels[i] = (PixelType)(0x9E3779B9U * (i + 1));
+			expected[i] = (PixelType)((((pixels[i] & keepMask) >> 2) | orBits) + addBits);
+		}
+
+		int done = Graphics::darkenFillSIMD(pixels, 21, keepMask, orBits, addBits);
+		for (int i = 0; i < done; i++)
+			TS_ASSERT_EQUALS(pixels[i], expected[i]);
+	}
+
+	static const Graphics::PixelFormat *formats(int &count) {
+		static const Graphics::PixelFormat kFormats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		count = ARRAYSIZE(kFormats);
+		return kFormats;
+	}
+
+	public:
+	void test_shapes() {
+		int count;
+		const Graphics::PixelFormat *format = formats(count);
+
+		for (int i = 0; i < count; i++) {
+			TS_ASSERT(compare(format[i], 300, 200));
+			TS_ASSERT(compare(format[i], 301, 197));
+		}
+	}
+
+	void test_blend_fill() {
+		int count;
+		const Graphics::PixelFormat *format = formats(count);
+
+		for (int i = 0; i < count; i++) {
+			if (format[i].bytesPerPixel == 4)
+				compareBlend<uint32>(format[i]);
+			else
+				compareBlend<uint16>(format[i]);
+		}
+	}
+
+	void test_darken_fill() {
+		// Both darkenFill() variants for RGB565 and ARGB8888
+		compareDarken<uint16>((uint16)~0x0861, 0, 0);
+		compareDarken<uint32>(~0x03030303U, 0, 0xC0000000U);
+		compareDarken<uint32>(~0x00030303U, 0xFF000000U, 0);
+	}
+};
@@ -0,0 +1,185 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/simd.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuva_to_rgba.h"
+
+#include "test/common/helper.h"
+
+/**
+ * Checks that the vectorized YUV converters give the same pixels as the
+ * lookup table code, whatever the format, luminance range, size and pitch.
+ */
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		k444,
+		k420,
+		k410,
+		kAlpha420
+	};
+
+	static void fillPlane(byte *plane, int size, uint32 seed) {
+		TestRandom rnd(seed);
+		for (int i = 0; i < size; i++)
+			plane[i] = (rnd.next() >> 16) & 0xFF;
+	}
+
+	static void convert(Graphics::Surface &dst, Subsampling mode, Graphics::YUVToRGBManager::LuminanceScale scale,
+	                    const byte *y, const byte *u, const byte *v, const byte *a, int width, int height, int yPitch, int uvPitch) {
+		switch (mode) {
+		case k444:
+			YUVToRGBMan.convert444(&dst, scale, y, u, v, width, height, yPitch, uvPitch);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&dst, scale, y, u, v, width, height, yPitch, uvPitch);
+			break;
+		case k410:
+			YUVToRGBMan.convert410(&dst, scale, y, u, v, width, height, yPitch, uvPitch);
+			break;
+		case kAlpha420:
+			YUVAToRGBAMan.convert420(&dst, (Graphics::YUVAToRGBAManager::LuminanceScale)scale, y, u, v, a, width, height, yPitch, uvPitch);
+			break;
+		}
+	}
+
+	/**
+	 * Convert random planes with and without SIMD and compare the results.
+	 * The source planes and the destination rows are padded by the given
+	 * number of pixels, which the converters must step over untouched.
+	 */
+	static bool compare(Subsampling mode, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height, int padding) {
+		int uvWidth = width, uvHeight = height;
+		if (mode == k420 || mode == kAlpha420) {
+			uvWidth = width / 2;
+			uvHeight = height / 2;
+		} else if (mode == k410) {
+			// One extra row and column, see convert410()
+			uvWidth = width / 4 + 1;
+			uvHeight = height / 4 + 1;
+		}
+
+		int yPitch = width + padding;
+		int uvPitch = uvWidth + padding;
+		byte *y = new byte[yPitch * height];
+		byte *a = new byte[yPitch * height];
+		byte *u = new byte[uvPitch * uvHeight];
+		byte *v = new byte[uvPitch * uvHeight];
+		fillPlane(y, yPitch * height, 1);
+		fillPlane(a, yPitch * height, 2);
+		fillPlane(u, uvPitch * uvHeight, 3);
+		fillPlane(v, uvPitch * uvHeight, 4);
+
+		int pitch = (width + padding) * format.bytesPerPixel;
+		byte *scalarPixels = new byte[pitch * height];
+		byte *simdPixels = new byte[pitch * height];
+		memset(scalarPixels, 0xCD, pitch * height);
+		memset(simdPixels, 0xCD, pitch * height);
+
+		Graphics::Surface scalar, simd;
+		scalar.init(width, height, pitch, scalarPixels, format);
+		simd.init(width, height, pitch, simdPixels, format);
+
+		Common::setSIMDEnabled(false);
+		convert(scalar, mode, scale, y, u, v, a, width, height, yPitch, uvPitch);
+		Common::setSIMDEnabled(true);
+		convert(simd, mode, scale, y, u, v, a, width, height, yPitch, uvPitch);
+
+		bool equal = memcmp(scalarPixels, simdPixels, pitch * height) == 0;
+
+		// The padding at the end of the rows must be left alone
+		for (int row = 0; row < height; row++) {
+			for (int i = width * format.bytesPerPixel; i < pitch; i++) {
+				if (simdPixels[row * pitch + i] != 0xCD)
+					equal = false;
+			}
+		}
+
+		delete[] scalarPixels;
+		delete[] simdPixels;
+		delete[] y;
+		delete[] a;
+		delete[] u;
+		delete[] v;
+		return equal;
+	}
+
+	static void compareAll(Subsampling mode, int width, int height, int padding = 0) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); i++) {
+			TS_ASSERT(compare(mode, formats[i], Graphics::YUVToRGBManager::kScaleFull, width, height, padding));
+			TS_ASSERT(compare(mode, formats[i], Graphics::YUVToRGBManager::kScaleITU, width, height, padding));
+		}
+	}
+
+	public:
+	void test_yuv444() {
+		compareAll(k444, 64, 16);
+		compareAll(k444, 37, 5);
+	}
+
+	void test_yuv420() {
+		compareAll(k420, 64, 16);
+		compareAll(k420, 38, 6);
+	}
+
+	void test_yuv420_padded() {
+		// The 4:2:0 converters need an even size, so use an odd number
+		// of chroma rows and columns, with a scalar tail after the SIMD
+		compareAll(k420, 50, 10, 7);
+		compareAll(k420, 70, 14, 16);
+		compareAll(k420, 2, 2, 3);
+		compareAll(kAlpha420, 50, 10, 7);
+	}
+
+	void test_yuv410() {
+		compareAll(k410, 64, 16);
+		compareAll(k410, 44, 8);
+	}
+
+	void test_yuva420() {
+		compareAll(kAlpha420, 64, 16);
+		compareAll(kAlpha420, 38, 6);
+	}
+
+	void test_all_chroma_values() {
+		// Every (u, v) pair with several luminances, through the 444 path
+		Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		byte *y = new byte[256 * 256];
+		byte *u = new byte[256 * 256];
+		byte *v = new byte[256 * 256];
+		for (int i = 0; i < 256; i++) {
+			for (int j = 0; j < 256; j++) {
+				y[i * 256 + j] = (i * 7 + j * 13) & 0xFF;
+				u[i * 256 + j] = j;
+				v[i * 256 + j] = i;
+			}
+		}
+
+		for (int s = 0; s < 2; s++) {
+			Graphics::YUVToRGBManager::LuminanceScale scale = s ? Graphics::YUVToRGBManager::kScaleITU : Graphics::YUVToRGBManager::kScaleFull;
+			Graphics::Surface scalar, simd;
+			scalar.create(256, 256, format);
+			simd.create(256, 256, format);
+
+			Common::setSIMDEnabled(false);
+			YUVToRGBMan.convert444(&scalar, scale, y, u, v, 256, 256, 256, 256);
+			Common::setSIMDEnabled(true);
+			YUVToRGBMan.convert444(&simd, scale, y, u, v, 256, 256, 256, 256);
+
+			TS_ASSERT_EQUALS(memcmp(scalar.getPixels(), simd.getPixels(), 256 * scalar.pitch), 0);
+			scalar.free();
+			simd.free();
+		}
+
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+};
@@ -31,7 +31,6 @@
 #include "common/textconsole.h"
 #include "common/math.h"
 #include "common/stream.h"
-#include "common/substream.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
@@ -39,6 +38,7 @@
 #include "common/rdft.h"
 #include "common/dct.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 
 #include "graphics/yuva_to_rgba.h" // ResidualVM specific
 #include "graphics/surface.h"
@@ -59,6 +59,11 @@ static const uint16 kAudioFlagStereo = 0x2000;
 // Number of bits used to store first DC value in bundle
 static const uint32 kDCStartBits = 11;
 
+// Number of worker threads transforming the DCT blocks of a frame
+static const uint kDecodeWorkers = 2;
+// Don't bother creating jobs for fewer DCT blocks than that
+static const uint32 kDCTSliceBlocksMin = 64;
+
 namespace Video {
 
 BinkDecoder::BinkDecoder() {
@@ -191,8 +196,12 @@ void BinkDecoder::readNextPacket() {
 				//                  Number of samples in bytes
 				audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-				audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-						audioPacketStart + 4, audioPacketEnd), true);
+				uint32 audioDataSize = audioPacketEnd - (audioPacketStart + 4);
+				byte *audioData = (byte *)malloc(audioDataSize);
+				if (_bink->read(audioData, audioDataSize) != audioDataSize)
+					error("Bink audio packet too short");
+
+				audio.bits = new Common::BitStreamMemory32LELSB(audioData, audioDataSize, DisposeAfterUse::YES);
 
 				audioTrack->decodePacket();
 
@@ -206,11 +215,12 @@ void BinkDecoder::readNextPacket() {
 		}
 	}
 
-	uint32 videoPacketStart = _bink->pos();
-	uint32 videoPacketEnd   = _bink->pos() + frameSize;
+	// The packet is decoded from memory, which the bit stream reads several bits at a time
+	byte *videoData = (byte *)malloc(frameSize);
+	if (_bink->read(videoData, frameSize) != frameSize)
+		error("Bink video packet too short");
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), true);
+	frame.bits = new Common::BitStreamMemory32LELSB(videoData, frameSize, DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
 
@@ -307,10 +317,31 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, const G
 
 	initBundles();
 	initHuffman();
+
+	_threadPool = new Common::ThreadPool(kDecodeWorkers);
+
+	for (int i = 0; i < 4; i++) {
+		_dctBlocks[i] = 0;
+		_dctBlockCount[i] = 0;
+		_planePitch[i] = 0;
+	}
+
+	// Without workers, the DCT blocks are transformed right away, in place
+	uint32 lumaBlocks   = ((_surface.w + 7) >> 3) * ((_surface.h + 7) >> 3);
+	uint32 chromaBlocks = ((_surface.w + 15) >> 4) * ((_surface.h + 15) >> 4);
+	for (int i = 0; i < 4; i++) {
+		bool isChroma = (i == 1) || (i == 2);
+		uint32 blocks = _threadPool->getNumWorkers() ? (isChroma ? chromaBlocks : lumaBlocks) : 1;
+		_dctBlocks[i] = new DCTBlock[blocks];
+	}
 }
 
 BinkDecoder::BinkVideoTrack::~BinkVideoTrack() {
+	delete _threadPool;
+
 	for (int i = 0; i < 4; i++) {
+		delete[] _dctBlocks[i]; _dctBlocks[i] = 0;
+
 		delete[] _curPlanes[i]; _curPlanes[i] = 0;
 		delete[] _oldPlanes[i]; _oldPlanes[i] = 0;
 	}
@@ -416,6 +447,9 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 			break;
 	}
 
+	// Wait for the deferred DCT blocks of all the planes
+	_threadPool->waitForJobs();
+
 	// Convert the YUV data we have to our format
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
@@ -447,6 +481,9 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	ctx.prevEnd   = _oldPlanes[planeIdx] + width * height;
 	ctx.pitch     = width;
 
+	_dctBlockCount[planeIdx] = 0;
+	_planePitch[planeIdx]    = width;
+
 	for (int i = 0; i < 64; i++) {
 		ctx.coordMap[i] = (i & 7) + (i >> 3) * ctx.pitch;
 
@@ -529,6 +566,83 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 	if (video.bits->pos() & 0x1F) // next plane data starts at 32-bit boundary
 		video.bits->skip(32 - (video.bits->pos() & 0x1F));
 
+	queueDCTBlocks(planeIdx);
+}
+
+BinkDecoder::BinkVideoTrack::DCTBlock &BinkDecoder::BinkVideoTrack::startDCTBlock(DecodeContext &ctx, DCTMode mode) {
+	DCTBlock &block = _dctBlocks[ctx.planeIdx][_dctBlockCount[ctx.planeIdx]];
+
+	memset(block.coeffs, 0, 64 * sizeof(int16));
+	block.dest = ctx.dest;
+	block.mode = mode;
+
+	return block;
+}
+
+void BinkDecoder::BinkVideoTrack::endDCTBlock(DecodeContext &ctx, DCTBlock &block) {
+	if (_threadPool->getNumWorkers())
+		_dctBlockCount[ctx.planeIdx]++;
+	else
+		transformDCTBlock(block, ctx.pitch);
+}
+
+void BinkDecoder::BinkVideoTrack::queueDCTBlocks(int planeIdx) {
+	uint32 count = _dctBlockCount[planeIdx];
+	if (count == 0)
+		return;
+
+	// Blocks never overlap and only depend on the previous frame, so the
+	// slices can be transformed in any order with the same result.
+	uint32 slices = CLIP<uint32>(count / kDCTSliceBlocksMin, 1, kDCTSlicesMax);
+	uint32 sliceSize = (count + slices - 1) / slices;
+
+	for (uint32 i = 0; i < slices; i++) {
+		DCTSlice &slice = _dctSlices[planeIdx][i];
+
+		slice.track    = this;
+		slice.planeIdx = planeIdx;
+		slice.start    = i * sliceSize;
+		slice.end      = MIN(count, slice.start + sliceSize);
+
+		if (slice.start < slice.end)
+			_threadPool->addJob(transformDCTSlice, &slice);
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::transformDCTSlice(void *data) {
+	DCTSlice *slice = (DCTSlice *)data;
+	BinkVideoTrack *track = slice->track;
+
+	DCTBlock *blocks = track->_dctBlocks[slice->planeIdx];
+	uint32 pitch = track->_planePitch[slice->planeIdx];
+
+	for (uint32 i = slice->start; i < slice->end; i++)
+		track->transformDCTBlock(blocks[i], pitch);
+}
+
+void BinkDecoder::BinkVideoTrack::transformDCTBlock(DCTBlock &block, uint32 pitch) {
+	switch (block.mode) {
+	case kDCTPut:
+		IDCTPut(block.dest, pitch, block.coeffs);
+		break;
+	case kDCTAdd:
+		IDCTAdd(block.dest, pitch, block.coeffs);
+		break;
+	case kDCTScaledPut: {
+		IDCT(block.coeffs);
+
+		int16 *src   = block.coeffs;
+		byte  *dest1 = block.dest;
+		byte  *dest2 = block.dest + pitch;
+		for (int j = 0; j < 8; j++, dest1 += (pitch << 1) - 16, dest2 += (pitch << 1) - 16, src += 8) {
+
+			for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
+				dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+
+		}
+		break;
+	}
+	}
 }
 
 void BinkDecoder::BinkVideoTrack::readBundle(VideoFrame &video, Source source) {
@@ -741,24 +855,13 @@ void BinkDecoder::BinkVideoTrack::blockScaledRun(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
-	int16 block[64];
-	memset(block, 0, 64 * sizeof(int16));
-
-	block[0] = getBundleValue(kSourceIntraDC);
+	DCTBlock &block = startDCTBlock(ctx, kDCTScaledPut);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	block.coeffs[0] = getBundleValue(kSourceIntraDC);
 
-	IDCT(block);
-
-	int16 *src   = block;
-	byte  *dest1 = ctx.dest;
-	byte  *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
-
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+	readDCTCoeffs(*ctx.video, block.coeffs, true);
 
-	}
+	endDCTBlock(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledFill(DecodeContext &ctx) {
@@ -886,14 +989,13 @@ void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
 }
 
 void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
-	int16 block[64];
-	memset(block, 0, 64 * sizeof(int16));
+	DCTBlock &block = startDCTBlock(ctx, kDCTPut);
 
-	block[0] = getBundleValue(kSourceIntraDC);
+	block.coeffs[0] = getBundleValue(kSourceIntraDC);
 
-	readDCTCoeffs(*ctx.video, block, true);
+	readDCTCoeffs(*ctx.video, block.coeffs, true);
 
-	IDCTPut(ctx, block);
+	endDCTBlock(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
@@ -907,14 +1009,13 @@ void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
 void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 	blockMotion(ctx);
 
-	int16 block[64];
-	memset(block, 0, 64 * sizeof(int16));
+	DCTBlock &block = startDCTBlock(ctx, kDCTAdd);
 
-	block[0] = getBundleValue(kSourceInterDC);
+	block.coeffs[0] = getBundleValue(kSourceInterDC);
 
-	readDCTCoeffs(*ctx.video, block, false);
+	readDCTCoeffs(*ctx.video, block.coeffs, false);
 
-	IDCTAdd(ctx, block);
+	endDCTBlock(ctx, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
@@ -1394,23 +1495,22 @@ void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTAdd(byte *dest, uint32 pitch, int16 *block) {
 	int i, j;
 
 	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	for (i = 0; i < 8; i++, dest += pitch, block += 8)
 		for (j = 0; j < 8; j++)
 			 dest[j] += block[j];
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int16 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTPut(byte *dest, uint32 pitch, int16 *block) {
 	int i;
 	int16 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
@@ -1480,23 +1580,24 @@ void BinkDecoder::BinkAudioTrack::audioBlockDCT() {
 		readAudioCoeffs(coeffs);
 
 		coeffs[0] /= 0.5;
+	}
+
+	// Transform all the channels in one go
+	_audioInfo->dct->calc(_audioInfo->coeffsPtr, _audioInfo->channels);
 
-		_audioInfo->dct->calc(coeffs);
+	for (uint8 i = 0; i < _audioInfo->channels; i++) {
+		float *coeffs = _audioInfo->coeffsPtr[i];
 
 		for (uint32 j = 0; j < _audioInfo->frameLen; j++)
 			coeffs[j] *= (_audioInfo->frameLen / 2.0);
 	}
-
 }
 
 void BinkDecoder::BinkAudioTrack::audioBlockRDFT() {
-	for (uint8 i = 0; i < _audioInfo->channels; i++) {
-		float *coeffs = _audioInfo->coeffsPtr[i];
-
-		readAudioCoeffs(coeffs);
+	for (uint8 i = 0; i < _audioInfo->channels; i++)
+		readAudioCoeffs(_audioInfo->coeffsPtr[i]);
 
-		_audioInfo->rdft->calc(coeffs);
-	}
+	_audioInfo->rdft->calc(_audioInfo->coeffsPtr, _audioInfo->channels);
 }
 
 static const uint8 rleLengthTab[16] = {
@@ -32,6 +32,7 @@
 #define VIDEO_BINK_DECODER_H
 
 #include "common/array.h"
+#include "common/bitstream.h"
 #include "common/rational.h"
 #include "graphics/surface.h" // ResidualVM specific
 
@@ -46,8 +47,8 @@ class QueuingAudioStream;
 
 namespace Common {
 class SeekableReadStream;
-class BitStream;
 class Huffman;
+class ThreadPool;
 
 class RDFT;
 class DCT;
@@ -102,7 +103,7 @@ private:
 
 		uint32 sampleCount;
 
-		Common::BitStream *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		bool first;
 
@@ -135,7 +136,7 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -218,6 +219,30 @@ private:
 			kBlockRaw           ///< Uncoded 8x8 block.
 		};
 
+		/** How a DCT block is written into the plane once transformed. */
+		enum DCTMode {
+			kDCTPut,      ///< Intra block, replaces the pixels.
+			kDCTAdd,      ///< Inter block, added to the motion compensated pixels.
+			kDCTScaledPut ///< Intra block of a 16x16 block, replaces the pixels at twice the size.
+		};
+
+		/** A DCT block whose inverse transform may be deferred to a worker thread. */
+		struct DCTBlock {
+			int16 coeffs[64];
+			byte *dest;
+			DCTMode mode;
+		};
+
+		/** A range of the DCT blocks of a plane, transformed by one job. */
+		struct DCTSlice {
+			BinkVideoTrack *track;
+			int planeIdx;
+			uint32 start;
+			uint32 end;
+		};
+
+		static const int kDCTSlicesMax = 8;
+
 		/** Data structure for decoding and tranlating Huffman'd data. */
 		struct Huffman {
 			int  index;       ///< Index of the Huffman codebook to use.
@@ -264,6 +289,19 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		/**
+		 * Workers running the inverse DCTs of a plane while the next plane is
+		 * being entropy decoded. The bitstream of a plane can only be located
+		 * by decoding the previous one, but once parsed, its blocks only depend
+		 * on the previous frame and don't overlap.
+		 */
+		Common::ThreadPool *_threadPool;
+
+		DCTBlock *_dctBlocks[4];  ///< Deferred DCT blocks of each plane, only with worker threads.
+		uint32 _dctBlockCount[4]; ///< Number of deferred DCT blocks of each plane.
+		uint32 _planePitch[4];    ///< Pitch of each plane, for the deferred DCT blocks.
+		DCTSlice _dctSlices[4][kDCTSlicesMax];
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -275,6 +313,17 @@ private:
 		/** Decode a plane. */
 		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 
+		/** Get the storage for the coefficients of a DCT block of the current plane. */
+		DCTBlock &startDCTBlock(DecodeContext &ctx, DCTMode mode);
+		/** Transform a DCT block, or keep it for the workers. */
+		void endDCTBlock(DecodeContext &ctx, DCTBlock &block);
+		/** Hand the deferred DCT blocks of a plane over to the workers. */
+		void queueDCTBlocks(int planeIdx);
+		/** Inverse transform a DCT block and write it into its plane. */
+		void transformDCTBlock(DCTBlock &block, uint32 pitch);
+		/** Thread pool job transforming a DCTSlice. */
+		static void transformDCTSlice(void *slice);
+
 		/** Read/Initialize a bundle for decoding a plane. */
 		void readBundle(VideoFrame &video, Source source);
 
@@ -321,8 +370,8 @@ private:
 
 		// Bink video IDCT
 		void IDCT(int16 *block);
-		void IDCTPut(DecodeContext &ctx, int16 *block);
-		void IDCTAdd(DecodeContext &ctx, int16 *block);
+		void IDCTPut(byte *dest, uint32 pitch, int16 *block);
+		void IDCTAdd(byte *dest, uint32 pitch, int16 *block);
 	};
 
 	class BinkAudioTrack : public AudioTrack {